@@ -1,13 +1,23 @@
 #include "Arguments.h"
 #include "Visitor.h"
+#include "Function.h"
+#include "NativeFunction.h"
 
 NS_STONE_BEGIN
 Arguments::Arguments()
+	:_cachedFunction(nullptr)
+	,_cachedSerial(0)
+	,_cachedLayout(nullptr)
+	,_cachedNative(nullptr)
 {
 }
 
 Arguments::Arguments(const std::vector<ASTree*>& list)
 	:Postfix(list)
+	,_cachedFunction(nullptr)
+	,_cachedSerial(0)
+	,_cachedLayout(nullptr)
+	,_cachedNative(nullptr)
 {
 }
 
@@ -20,6 +30,29 @@ unsigned Arguments::getSize() const
 	return getNumChildren();
 }
 
+bool Arguments::isCached(Function* function) const
+{
+	//ַܱµĺãҪͬʱȽ
+	return function == _cachedFunction && function->getSerial() == _cachedSerial;
+}
+
+void Arguments::updateCache(Function* function)
+{
+	_cachedFunction = function;
+	_cachedSerial = function->getSerial();
+	_cachedLayout = function->getFrameLayout();
+	//ٵõıغҪ
+	NativeFunction* native = dynamic_cast<NativeFunction*>(function);
+	_cachedNative = native != nullptr && native->isFast() ? native : nullptr;
+	//ְʱԤȡ
+	_cachedParams.clear();
+	if (_cachedLayout == nullptr && _cachedNative == nullptr)
+	{
+		for (unsigned int i = 0; i < function->getParamSize(); i++)
+			_cachedParams.push_back(function->getParamName(i));
+	}
+}
+
 void Arguments::accept(Visitor* v, Environment* env)
 {
 	v->visit(this, env);
@@ -2,6 +2,7 @@
 #define __Stone_Arguments_H__
 
 #include <vector>
+#include <string>
 
 #include "Postfix.h"
 
@@ -9,6 +10,9 @@ NS_STONE_BEGIN
 
 class Visitor;
 class Environment;
+class Function;
+class FrameLayout;
+class NativeFunction;
 
 class Arguments : public Postfix
 {
@@ -18,8 +22,26 @@ public:
 	virtual ~Arguments();
 
 	unsigned getSize() const;
+
+	//棬¼һεõĺ󶨷ʽ
+	//ǷΪһεõĺ
+	bool isCached(Function* function) const;
+	//»棬ǰѼ
+	void updateCache(Function* function);
+	//溯ջ֣֡ΪnullptrҪְ󶨲
+	FrameLayout* getCachedLayout() const { return _cachedLayout; }
+	//溯Ϊٵõıغʱظú򷵻nullptr
+	NativeFunction* getCachedNative() const { return _cachedNative; }
+	const std::string& getCachedParamName(unsigned index) const { return _cachedParams[index]; }
 public:
 	virtual void accept(Visitor* v, Environment* env);
+private:
+	//ֻڱȽϣ֤ȻЧ
+	Function* _cachedFunction;
+	unsigned int _cachedSerial;
+	FrameLayout* _cachedLayout;
+	NativeFunction* _cachedNative;
+	std::vector<std::string> _cachedParams;
 };
 NS_STONE_END
 #endif
\ No newline at end of file
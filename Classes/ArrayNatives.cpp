@@ -0,0 +1,146 @@
+#include <climits>
+
+#include "ArrayNatives.h"
+#include "Environment.h"
+#include "StoneException.h"
+#include "PersistentVector.h"
+#include "ArrayView.h"
+
+NS_STONE_BEGIN
+
+typedef NativeFunction::ArgMode ArgMode;
+
+//ȡendΪtrueʱ鳤
+static unsigned int toIndex(const ValueVector& list, const Value& index, bool end)
+{
+	if (index.getType() != Value::Type::INTEGER)
+		throw StoneException("bad array index");
+
+	int64_t i = index.asLong();
+	int64_t size = (int64_t)list.size();
+	if (i < 0 || i > size || (i == size && !end))
+		throw StoneException("array index out of range");
+	return (unsigned int)i;
+}
+
+//push(a, v) ĩβԪأµĳ
+static void push(Value* args, unsigned int argc, Value* ret)
+{
+	auto& list = args[0].asValueVector();
+	list.push_back(std::move(args[1]));
+	*ret = (int)list.size();
+}
+
+//pop(a) ƳĩβԪ
+static void pop(Value* args, unsigned int argc, Value* ret)
+{
+	auto& list = args[0].asValueVector();
+	if (list.empty())
+		throw StoneException("pop from empty array");
+	*ret = std::move(list.back());
+	list.pop_back();
+}
+
+//insert(a, i, v) iԪأµĳ
+static void insert(Value* args, unsigned int argc, Value* ret)
+{
+	auto& list = args[0].asValueVector();
+	unsigned int index = toIndex(list, args[1], true);
+	list.insert(list.begin() + index, std::move(args[2]));
+	*ret = (int)list.size();
+}
+
+//remove(a, i) ƳiԪ
+static void remove(Value* args, unsigned int argc, Value* ret)
+{
+	auto& list = args[0].asValueVector();
+	unsigned int index = toIndex(list, args[1], false);
+	*ret = std::move(list[index]);
+	list.erase(list.begin() + index);
+}
+
+//len(a) ȡ顢mapַĳ
+static void len(Value* args, unsigned int argc, Value* ret)
+{
+	const char* data = nullptr;
+	size_t size = 0;
+
+	if (args[0].getChars(data, size))
+		*ret = (int)size;
+	else if (args[0].getType() == Value::Type::MAP)
+		*ret = (int)args[0].asValueMap().size();
+	else if (args[0].getType() == Value::Type::PERSISTENT_VECTOR)
+		*ret = (int)args[0].asPersistentVector()->size();
+	//ͼҪƳ
+	else if (args[0].getType() == Value::Type::ARRAY_VIEW)
+		*ret = (int)args[0].asArrayView()->size();
+	else
+		*ret = (int)args[0].asValueVector().size();
+}
+
+//reserve(a, n) Ԥȷռ䣬ĳ
+static void reserve(Value* args, unsigned int argc, Value* ret)
+{
+	auto& list = args[0].asValueVector();
+	if (args[1].getType() != Value::Type::INTEGER || args[1].asLong() < 0 || args[1].asLong() > INT_MAX)
+		throw StoneException("bad reserve size");
+	list.reserve(args[1].asInt());
+	*ret = (int)list.size();
+}
+
+//pvec(a) 鴴־û
+static void pvec(Value* args, unsigned int argc, Value* ret)
+{
+	const Value* data = nullptr;
+	unsigned int size = 0;
+	//ֻȡԪأͼᱻתΪ
+	if (!args[0].getElements(data, size))
+		throw StoneException("the type is not vector");
+	PersistentVector* vector = PersistentVector::create(data, size);
+	*ret = Value(vector);
+	vector->release();
+}
+
+//assoc(p, i, v) i޸Ϊv°汾p
+static void assoc(Value* args, unsigned int argc, Value* ret)
+{
+	PersistentVector* vector = args[0].asPersistentVector();
+	if (args[1].getType() != Value::Type::INTEGER || args[1].asLong() < 0 || args[1].asLong() >= (int64_t)vector->size())
+		throw StoneException("array index out of range");
+
+	vector = vector->assoc(args[1].asInt(), args[2]);
+	*ret = Value(vector);
+	vector->release();
+}
+
+//conj(p, v) ĩβv°汾p
+static void conj(Value* args, unsigned int argc, Value* ret)
+{
+	PersistentVector* vector = args[0].asPersistentVector()->push(args[1]);
+	*ret = Value(vector);
+	vector->release();
+}
+
+//toArray(p) ѳ־ûתΪͨ
+static void toArray(Value* args, unsigned int argc, Value* ret)
+{
+	*ret = Value(args[0].asPersistentVector()->toVector());
+}
+
+void registerArrayNatives(Environment* env)
+{
+	//鰴ô룬Ḵ
+	env->putNative("push", push, 2, ArgMode::WRITE);
+	env->putNative("pop", pop, 1, ArgMode::WRITE);
+	env->putNative("insert", insert, 3, ArgMode::WRITE);
+	env->putNative("remove", remove, 2, ArgMode::WRITE);
+	env->putNative("reserve", reserve, 2, ArgMode::WRITE);
+	//ֻȡ飬пԴ빲ı
+	env->putNative("len", len, 1, ArgMode::READ);
+	env->putNative("pvec", pvec, 1, ArgMode::READ);
+	//־ûĸֻüֵ
+	env->putNative("assoc", assoc, 3);
+	env->putNative("conj", conj, 2);
+	env->putNative("toArray", toArray, 1);
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,18 @@
+#ifndef __Stone_ArrayNatives_H__
+#define __Stone_ArrayNatives_H__
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class Environment;
+
+/*
+	صıغ push pop insert remove len reserve
+	鰴ô룬ֱ޸ĵ߱е
+	Լ־û pvec assoc conj toArray
+*/
+void registerArrayNatives(Environment* env);
+
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "ArrayParser.h"
 #include "ArrayLiteral.h"
 #include "ArrayRef.h"
+#include "MapLiteral.h"
+#include "SliceRef.h"
 
 NS_STONE_BEGIN
 
@@ -11,11 +13,19 @@ bool ArrayParser::isHasPostfix()
 
 ASTree* ArrayParser::postfix()
 {
-	//postfix: "(" [args] ")" | "[" expr "]"
+	//postfix: "(" [args] ")" | "[" expr "]" | "[" [expr] ":" [expr] "]"
 	if (isToken("["))
 	{
 		token("[");
-		auto expr = expression();
+		ASTree* expr = isToken(":") ? nullptr : expression();
+		//Ƭ˶ʡ
+		if (isToken(":"))
+		{
+			token(":");
+			ASTree* high = isToken("]") ? nullptr : expression();
+			token("]");
+			return new SliceRef(expr, high);
+		}
 		token("]");
 		return new ArrayRef(expr);
 	}
@@ -25,14 +35,25 @@ ASTree* ArrayParser::postfix()
 
 ASTree* ArrayParser::primary()
 {
-	//primary: ( "{" [elements] "}" | "(" expression ")" | NUMBER | IDENTIFIER | STRING){postfix} | "fun" param_list block
+	//primary: ( "{" [elements | pairs | ":"] "}" | "(" expression ")" | NUMBER | IDENTIFIER | STRING){postfix} | "fun" param_list block
 	ASTree* elements = nullptr;
 	if (isToken("{"))
 	{
 		token("{");
-		if (!isToken("}"))
+		//{:}Ϊյmap
+		if (isToken(":"))
 		{
-			elements = this->elements();
+			token(":");
+			elements = new MapLiteral();
+		}
+		else if (!isToken("}"))
+		{
+			//һԪغ":"Ϊmap
+			auto first = BasicParser::expression();
+			if (isToken(":"))
+				elements = this->pairs(first);
+			else
+				elements = this->elements(first);
 		}
 		token("}");
 
@@ -44,11 +65,11 @@ ASTree* ArrayParser::primary()
 		return ClosureParser::primary();
 }
 
-ASTree* ArrayParser::elements()
+ASTree* ArrayParser::elements(ASTree* first)
 {
 	//elements: expr { "," expr }
 	std::vector<ASTree*> list;
-	list.push_back(BasicParser::expression());
+	list.push_back(first);
 
 	while (isToken(","))
 	{
@@ -58,4 +79,23 @@ ASTree* ArrayParser::elements()
 
 	return new ArrayLiteral(list);
 }
-NS_STONE_END
+
+ASTree* ArrayParser::pairs(ASTree* key)
+{
+	//pairs: expr ":" expr { "," expr ":" expr }
+	std::vector<ASTree*> list;
+	list.push_back(key);
+	token(":");
+	list.push_back(BasicParser::expression());
+
+	while (isToken(","))
+	{
+		token(",");
+		list.push_back(BasicParser::expression());
+		token(":");
+		list.push_back(BasicParser::expression());
+	}
+
+	return new MapLiteral(list);
+}
+NS_STONE_END
\ No newline at end of file
@@ -9,14 +9,16 @@ class ArrayParser : public ClosureParser
 public:
 	//Ƿpostfix
 	virtual bool isHasPostfix();
-	//postfix: "(" [args] ")" | "[" expr "]"
+	//postfix: "(" [args] ")" | "[" expr "]" | "[" [expr] ":" [expr] "]"
 	virtual ASTree* postfix();
 
-	//primary: ( "[" [elements] "]" | "(" expression ")" | NUMBER | IDENTIFIER | STRING){postfix} | "fun" param_list block
+	//primary: ( "{" [elements | pairs | ":"] "}" | "(" expression ")" | NUMBER | IDENTIFIER | STRING){postfix} | "fun" param_list block
 	virtual ASTree* primary();
 
-	//elements: expr { "," expr }
-	ASTree* elements();
+	//elements: expr { "," expr }firstΪѾĵһԪ
+	ASTree* elements(ASTree* first);
+	//pairs: expr ":" expr { "," expr ":" expr }keyΪѾĵһ
+	ASTree* pairs(ASTree* key);
 };
 NS_STONE_END
 
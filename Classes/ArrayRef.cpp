@@ -1,16 +1,49 @@
 #include "ArrayRef.h"
 #include "Visitor.h"
 #include "Environment.h"
+#include "NumberLiteral.h"
+#include "StringLiteral.h"
+#include "Name.h"
+#include "NegativeExpr.h"
+#include "BinaryExpr.h"
+#include "PrimaryExpr.h"
+#include "SliceRef.h"
 
 NS_STONE_BEGIN
 ArrayRef::ArrayRef(ASTree* t)
 {
 	_children.push_back(t);
+	_pure = isPureExpr(t);
 }
 
 ArrayRef::ArrayRef(const std::vector<ASTree*>& list)
 	:ASTList(list)
 {
+	_pure = isPureExpr(this->getIndex());
+}
+
+bool ArrayRef::isPureExpr(ASTree* t)
+{
+	if (dynamic_cast<NumberLiteral*>(t) != nullptr || dynamic_cast<StringLiteral*>(t) != nullptr || dynamic_cast<Name*>(t) != nullptr)
+		return true;
+	NegativeExpr* negative = dynamic_cast<NegativeExpr*>(t);
+	if (negative != nullptr)
+		return isPureExpr(negative->getOperand());
+	BinaryExpr* binary = dynamic_cast<BinaryExpr*>(t);
+	if (binary != nullptr)
+		return binary->getOperator() != "=" && isPureExpr(binary->getLeft()) && isPureExpr(binary->getRight());
+	//׺ֻ±Ƭÿ޸ı
+	PrimaryExpr* primary = dynamic_cast<PrimaryExpr*>(t);
+	if (primary == nullptr || !isPureExpr(primary->getChild(0)))
+		return false;
+	for (int i = 1; i < primary->getNumChildren(); i++)
+	{
+		ArrayRef* ref = dynamic_cast<ArrayRef*>(primary->getChild(i));
+		SliceRef* slice = dynamic_cast<SliceRef*>(primary->getChild(i));
+		if ((ref == nullptr || !ref->isPure()) && (slice == nullptr || !slice->isPure()))
+			return false;
+	}
+	return true;
 }
 
 ASTree* ArrayRef::getIndex() const
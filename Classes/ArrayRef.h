@@ -19,9 +19,16 @@ public:
 	ArrayRef(ASTree* t);
 	ArrayRef(const std::vector<ASTree*>& list);
 	ASTree* getIndex() const;
+	//Ƿûи
+	bool isPure() const { return _pure; }
+	//ʽǷûиã޸κα
+	//ֵֻԼõ±Ƭ
+	static bool isPureExpr(ASTree* t);
 public:
 	virtual void accept(Visitor* v, Environment* env);
 	virtual std::string toString() const;
+private:
+	bool _pure;
 };
 NS_STONE_END
 #endif
\ No newline at end of file
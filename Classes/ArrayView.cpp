@@ -0,0 +1,34 @@
+#include "ArrayView.h"
+
+NS_STONE_BEGIN
+
+ArrayView::ArrayView(ArrayBuffer* buffer, unsigned int offset, unsigned int length)
+	:_buffer(buffer)
+	,_offset(offset)
+	,_length(length)
+{
+	_buffer->retain();
+}
+
+ArrayView::~ArrayView()
+{
+	_buffer->release();
+}
+
+ArrayView* ArrayView::slice(unsigned int low, unsigned int high) const
+{
+	return new ArrayView(_buffer, _offset + low, high - low);
+}
+
+ValueVector ArrayView::detach()
+{
+	//ûͼֵøô洢
+	if (this->getReferenceCount() == 1 && _buffer->getReferenceCount() == 1
+		&& _offset == 0 && _length == _buffer->values.size())
+	{
+		return std::move(_buffer->values);
+	}
+	auto begin = _buffer->values.begin() + _offset;
+	return ValueVector(begin, begin + _length);
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef __Stone_ArrayView_H__
+#define __Stone_ArrayView_H__
+
+#include "STObject.h"
+#include "Value.h"
+
+NS_STONE_BEGIN
+
+/*
+	ͼĴ洢
+*/
+class ArrayBuffer : public Object
+{
+public:
+	ValueVector values;
+};
+
+/*
+	ͼù洢дoffsetʼlengthԪ
+	ƬʱԭƬͬһ洢ֻ޸ʱŸ(дʱ)
+*/
+class ArrayView : public Object
+{
+public:
+	ArrayView(ArrayBuffer* buffer, unsigned int offset, unsigned int length);
+	virtual ~ArrayView();
+
+	unsigned int size() const { return _length; }
+	//ȡԪأindexСsize()
+	const Value& at(unsigned int index) const { return _buffer->values[_offset + index]; }
+	//ͼ[low, high)صĶüΪ1
+	ArrayView* slice(unsigned int low, unsigned int high) const;
+	//ȡͼеԪأ洢ֻͼҷΧʱֱƶ
+	ValueVector detach();
+private:
+	ArrayBuffer* _buffer;
+	unsigned int _offset;
+	unsigned int _length;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
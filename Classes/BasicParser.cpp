@@ -11,6 +11,8 @@
 #include "BlockStmnt.h"
 #include "IfStmnt.h"
 #include "WhileStmnt.h"
+#include "ForStmnt.h"
+#include "YieldStmnt.h"
 
 NS_STONE_BEGIN
 //------------------------------------Operators-------------------------------------
@@ -106,6 +108,8 @@ ASTree* BasicParser::statement()
 	/*
 		statement: "if" expr block { "elseif" expr block} ["else" [EOL] block]
 				 | "while" expr block
+				 | "for" IDENTIFIER "in" expr block
+				 | "yield" expr
 				 | simple
 	*/
 	if (isToken("if"))
@@ -145,6 +149,30 @@ ASTree* BasicParser::statement()
 		WhileStmnt* whileStmnt = new WhileStmnt(list);
 		return whileStmnt;
 	}
+	//
+	else if (isToken("for"))
+	{
+		token("for");
+		std::vector<ASTree*> list;
+		Token* t = _lexer->read();
+		if (t->getType() != Token::Type::Identifier || _reserved.find(t->asString()) != _reserved.end())
+			throw ParseException(t);
+		list.push_back(new Name(t));
+		token("in");
+		list.push_back(this->expression());
+		list.push_back(this->block());
+
+		return new ForStmnt(list);
+	}
+	//ֵ
+	else if (isToken("yield"))
+	{
+		token("yield");
+		std::vector<ASTree*> list;
+		list.push_back(this->expression());
+
+		return new YieldStmnt(list);
+	}
 	else
 		return this->simple();
 }
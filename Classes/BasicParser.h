@@ -61,6 +61,8 @@ public:
 	/*
 		statement: "if" expr block ["else" block]
 				 | "while" expr block
+				 | "for" IDENTIFIER "in" expr block
+				 | "yield" expr
 				 | simple
 	*/
 	ASTree* statement();
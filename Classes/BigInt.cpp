@@ -0,0 +1,470 @@
+#include <algorithm>
+
+#include "BigInt.h"
+#include "StoneException.h"
+
+//ÿһλĻ
+#define BASE 0x100000000ULL
+//ڸλʱʹKaratsuba˷
+#define KARATSUBA_THRESHOLD 32
+//תʮʱÿδλ
+#define DECIMAL_DIGITS 9
+#define DECIMAL_BASE 1000000000U
+
+NS_STONE_BEGIN
+
+typedef BigInt::Digits Digits;
+
+//ȥλ0
+static void trim(Digits& digits)
+{
+	while (!digits.empty() && digits.back() == 0)
+		digits.pop_back();
+}
+
+static int compareDigits(const Digits& left, const Digits& right)
+{
+	if (left.size() != right.size())
+		return left.size() < right.size() ? -1 : 1;
+	for (size_t i = left.size(); i-- > 0;)
+	{
+		if (left[i] != right[i])
+			return left[i] < right[i] ? -1 : 1;
+	}
+	return 0;
+}
+
+static Digits addDigits(const Digits& left, const Digits& right)
+{
+	const Digits& longer = left.size() >= right.size() ? left : right;
+	const Digits& shorter = left.size() >= right.size() ? right : left;
+	Digits ret(longer.size() + 1, 0);
+	uint64_t carry = 0;
+
+	for (size_t i = 0; i < longer.size(); i++)
+	{
+		uint64_t sum = (uint64_t)longer[i] + (i < shorter.size() ? shorter[i] : 0) + carry;
+		ret[i] = (uint32_t)sum;
+		carry = sum >> 32;
+	}
+	ret[longer.size()] = (uint32_t)carry;
+	trim(ret);
+	return ret;
+}
+
+//leftСright
+static Digits subDigits(const Digits& left, const Digits& right)
+{
+	Digits ret(left.size(), 0);
+	int64_t borrow = 0;
+
+	for (size_t i = 0; i < left.size(); i++)
+	{
+		int64_t diff = (int64_t)left[i] - (i < right.size() ? right[i] : 0) - borrow;
+		borrow = diff < 0 ? 1 : 0;
+		ret[i] = (uint32_t)(diff + (borrow ? (int64_t)BASE : 0));
+	}
+	trim(ret);
+	return ret;
+}
+
+//digitsshiftλӵretϣretĳ㹻ɽ
+static void addShifted(Digits& ret, const Digits& digits, size_t shift)
+{
+	uint64_t carry = 0;
+	size_t i = 0;
+
+	for (; i < digits.size(); i++)
+	{
+		uint64_t sum = (uint64_t)ret[i + shift] + digits[i] + carry;
+		ret[i + shift] = (uint32_t)sum;
+		carry = sum >> 32;
+	}
+	for (i += shift; carry != 0; i++)
+	{
+		uint64_t sum = (uint64_t)ret[i] + carry;
+		ret[i] = (uint32_t)sum;
+		carry = sum >> 32;
+	}
+}
+
+static Digits multiplySchool(const Digits& left, const Digits& right)
+{
+	Digits ret(left.size() + right.size(), 0);
+
+	for (size_t i = 0; i < left.size(); i++)
+	{
+		uint64_t carry = 0;
+		for (size_t j = 0; j < right.size(); j++)
+		{
+			uint64_t cur = (uint64_t)left[i] * right[j] + ret[i + j] + carry;
+			ret[i + j] = (uint32_t)cur;
+			carry = cur >> 32;
+		}
+		ret[i + right.size()] = (uint32_t)carry;
+	}
+	trim(ret);
+	return ret;
+}
+
+//Karatsuba˷(a1*B^m + a0)(b1*B^m + b0) = z2*B^2m + z1*B^m + z0
+// z1 = (a0 + a1)(b0 + b1) - z0 - z2ֻҪεݹ˷
+static Digits multiplyDigits(const Digits& left, const Digits& right)
+{
+	if (left.empty() || right.empty())
+		return Digits();
+	if (left.size() < KARATSUBA_THRESHOLD || right.size() < KARATSUBA_THRESHOLD)
+		return multiplySchool(left, right);
+
+	size_t half = std::max(left.size(), right.size()) / 2;
+	auto split = [half](const Digits& digits, Digits& low, Digits& high)
+	{
+		size_t mid = std::min(half, digits.size());
+		low.assign(digits.begin(), digits.begin() + mid);
+		high.assign(digits.begin() + mid, digits.end());
+		trim(low);
+	};
+	Digits a0, a1, b0, b1;
+	split(left, a0, a1);
+	split(right, b0, b1);
+
+	Digits z0 = multiplyDigits(a0, b0);
+	Digits z2 = multiplyDigits(a1, b1);
+	Digits z1 = multiplyDigits(addDigits(a0, a1), addDigits(b0, b1));
+	z1 = subDigits(subDigits(z1, z0), z2);
+
+	Digits ret(left.size() + right.size() + 1, 0);
+	addShifted(ret, z0, 0);
+	addShifted(ret, z1, half);
+	addShifted(ret, z2, half * 2);
+	trim(ret);
+	return ret;
+}
+
+//һλ
+static uint32_t divideSmall(Digits& digits, uint32_t divisor)
+{
+	uint64_t rem = 0;
+
+	for (size_t i = digits.size(); i-- > 0;)
+	{
+		uint64_t cur = (rem << 32) | digits[i];
+		digits[i] = (uint32_t)(cur / divisor);
+		rem = cur % divisor;
+	}
+	trim(digits);
+	return (uint32_t)rem;
+}
+
+static int leadingZeros(uint32_t value)
+{
+	int count = 0;
+	while (!(value & 0x80000000U))
+	{
+		value <<= 1;
+		count++;
+	}
+	return count;
+}
+
+//Knuth㷨DdivisorΪ0
+static void divideDigits(const Digits& dividend, const Digits& divisor, Digits& quotient, Digits& remainder)
+{
+	if (compareDigits(dividend, divisor) < 0)
+	{
+		quotient.clear();
+		remainder = dividend;
+		return;
+	}
+	if (divisor.size() == 1)
+	{
+		quotient = dividend;
+		uint32_t rem = divideSmall(quotient, divisor[0]);
+		remainder.clear();
+		if (rem != 0)
+			remainder.push_back(rem);
+		return;
+	}
+	//淶ʹλΪ1
+	int shift = leadingZeros(divisor.back());
+	size_t n = divisor.size(), m = dividend.size() - n;
+	Digits v(n), u(dividend.size() + 1);
+
+	for (size_t i = n - 1; i > 0; i--)
+		v[i] = (divisor[i] << shift) | (shift ? divisor[i - 1] >> (32 - shift) : 0);
+	v[0] = divisor[0] << shift;
+	u[dividend.size()] = shift ? dividend.back() >> (32 - shift) : 0;
+	for (size_t i = dividend.size() - 1; i > 0; i--)
+		u[i] = (dividend[i] << shift) | (shift ? dividend[i - 1] >> (32 - shift) : 0);
+	u[0] = dividend[0] << shift;
+
+	quotient.assign(m + 1, 0);
+	for (size_t j = m + 1; j-- > 0;)
+	{
+		//̣2
+		uint64_t num = ((uint64_t)u[j + n] << 32) | u[j + n - 1];
+		uint64_t qhat = num / v[n - 1];
+		uint64_t rhat = num % v[n - 1];
+		while (qhat >= BASE || qhat * v[n - 2] > ((rhat << 32) | u[j + n - 2]))
+		{
+			qhat--;
+			rhat += v[n - 1];
+			if (rhat >= BASE)
+				break;
+		}
+		//ȥ qhat * v
+		int64_t borrow = 0;
+		uint64_t carry = 0;
+		for (size_t i = 0; i < n; i++)
+		{
+			uint64_t product = qhat * v[i] + carry;
+			carry = product >> 32;
+			int64_t diff = (int64_t)u[i + j] - borrow - (int64_t)(product & 0xFFFFFFFFULL);
+			u[i + j] = (uint32_t)diff;
+			borrow = diff < 0 ? 1 : 0;
+		}
+		int64_t diff = (int64_t)u[j + n] - borrow - (int64_t)carry;
+		u[j + n] = (uint32_t)diff;
+		//ˣӻȥ
+		if (diff < 0)
+		{
+			qhat--;
+			carry = 0;
+			for (size_t i = 0; i < n; i++)
+			{
+				uint64_t sum = (uint64_t)u[i + j] + v[i] + carry;
+				u[i + j] = (uint32_t)sum;
+				carry = sum >> 32;
+			}
+			u[j + n] += (uint32_t)carry;
+		}
+		quotient[j] = (uint32_t)qhat;
+	}
+	//ԭ
+	remainder.assign(n, 0);
+	for (size_t i = 0; i < n; i++)
+		remainder[i] = (u[i] >> shift) | (shift ? (uint32_t)((uint64_t)u[i + 1] << (32 - shift)) : 0);
+	trim(quotient);
+	trim(remainder);
+}
+
+//ȡߴķź;ֵľֵstorage
+static const Digits& toDigits(const Value& value, Digits& storage, bool& negative)
+{
+	if (value.getType() == Value::Type::BIG_INTEGER)
+	{
+		negative = value.asBigInt()->isNegative();
+		return value.asBigInt()->getDigits();
+	}
+	int64_t number = value.asLong();
+	uint64_t magnitude = number < 0 ? 0 - (uint64_t)number : (uint64_t)number;
+
+	negative = number < 0;
+	storage.clear();
+	if (magnitude != 0)
+		storage.push_back((uint32_t)magnitude);
+	if (magnitude >> 32)
+		storage.push_back((uint32_t)(magnitude >> 32));
+	return storage;
+}
+
+//зżӷķŲͬʱ
+static Value addSigned(bool leftNegative, const Digits& left, bool rightNegative, const Digits& right)
+{
+	if (leftNegative == rightNegative)
+		return BigInt::toValue(leftNegative, addDigits(left, right));
+	if (compareDigits(left, right) >= 0)
+		return BigInt::toValue(leftNegative, subDigits(left, right));
+	return BigInt::toValue(rightNegative, subDigits(right, left));
+}
+//-------------------------------BigInt------------------------------
+BigInt::BigInt(bool negative, Digits&& digits)
+	:_negative(negative)
+	,_digits(std::move(digits))
+{
+}
+
+BigInt::~BigInt()
+{
+}
+
+BigInt* BigInt::create(const std::string& text)
+{
+	bool negative = !text.empty() && text[0] == '-';
+	size_t start = negative ? 1 : 0;
+	Digits digits;
+	//ÿζȡ9λʮ
+	for (size_t i = start; i < text.size(); i += DECIMAL_DIGITS)
+	{
+		size_t count = std::min<size_t>(DECIMAL_DIGITS, text.size() - i);
+		uint64_t chunk = 0, scale = 1;
+
+		for (size_t k = 0; k < count; k++)
+		{
+			if (text[i + k] < '0' || text[i + k] > '9')
+				throw StoneException("bad integer: " + text);
+			chunk = chunk * 10 + (text[i + k] - '0');
+			scale *= 10;
+		}
+		//digits = digits * scale + chunk
+		uint64_t carry = chunk;
+		for (auto& digit : digits)
+		{
+			uint64_t cur = (uint64_t)digit * scale + carry;
+			digit = (uint32_t)cur;
+			carry = cur >> 32;
+		}
+		if (carry != 0)
+			digits.push_back((uint32_t)carry);
+	}
+	trim(digits);
+	return new BigInt(negative && !digits.empty(), std::move(digits));
+}
+
+std::string BigInt::toString() const
+{
+	if (_digits.empty())
+		return "0";
+	Digits digits = _digits;
+	std::vector<uint32_t> chunks;
+	//ӵλʼÿȡ9λʮ
+	while (!digits.empty())
+		chunks.push_back(divideSmall(digits, DECIMAL_BASE));
+
+	std::string ret = _negative ? "-" : "";
+	ret += std::to_string(chunks.back());
+	for (size_t i = chunks.size() - 1; i-- > 0;)
+	{
+		std::string chunk = std::to_string(chunks[i]);
+		ret.append(DECIMAL_DIGITS - chunk.size(), '0');
+		ret += chunk;
+	}
+	return ret;
+}
+
+double BigInt::toDouble() const
+{
+	double ret = 0.0;
+
+	for (size_t i = _digits.size(); i-- > 0;)
+		ret = ret * (double)BASE + _digits[i];
+	return _negative ? -ret : ret;
+}
+
+int64_t BigInt::toLong() const
+{
+	uint64_t magnitude = 0;
+
+	if (_digits.size() > 0)
+		magnitude = _digits[0];
+	if (_digits.size() > 1)
+		magnitude |= (uint64_t)_digits[1] << 32;
+	return (int64_t)(_negative ? 0 - magnitude : magnitude);
+}
+
+bool BigInt::equals(const BigInt* other) const
+{
+	return _negative == other->_negative && _digits == other->_digits;
+}
+
+Value BigInt::toValue(bool negative, Digits&& digits)
+{
+	trim(digits);
+	//ܷint64ʱɶ
+	if (digits.size() <= 2)
+	{
+		uint64_t magnitude = 0;
+		if (digits.size() > 0)
+			magnitude = digits[0];
+		if (digits.size() > 1)
+			magnitude |= (uint64_t)digits[1] << 32;
+
+		if (!negative && magnitude <= (uint64_t)INT64_MAX)
+			return Value((int64_t)magnitude);
+		if (negative && magnitude <= (uint64_t)INT64_MAX + 1)
+			return Value((int64_t)(0 - magnitude));
+	}
+	BigInt* number = new BigInt(negative, std::move(digits));
+	Value value = Value(number);
+	number->release();
+	return value;
+}
+
+Value BigInt::add(const Value& left, const Value& right)
+{
+	Digits leftStorage, rightStorage;
+	bool leftNegative = false, rightNegative = false;
+	auto& a = toDigits(left, leftStorage, leftNegative);
+	auto& b = toDigits(right, rightStorage, rightNegative);
+
+	return addSigned(leftNegative, a, rightNegative, b);
+}
+
+Value BigInt::subtract(const Value& left, const Value& right)
+{
+	Digits leftStorage, rightStorage;
+	bool leftNegative = false, rightNegative = false;
+	auto& a = toDigits(left, leftStorage, leftNegative);
+	auto& b = toDigits(right, rightStorage, rightNegative);
+
+	return addSigned(leftNegative, a, !rightNegative, b);
+}
+
+Value BigInt::multiply(const Value& left, const Value& right)
+{
+	Digits leftStorage, rightStorage;
+	bool leftNegative = false, rightNegative = false;
+	auto& a = toDigits(left, leftStorage, leftNegative);
+	auto& b = toDigits(right, rightStorage, rightNegative);
+
+	return toValue(leftNegative != rightNegative, multiplyDigits(a, b));
+}
+
+Value BigInt::divide(const Value& left, const Value& right)
+{
+	Digits leftStorage, rightStorage, quotient, remainder;
+	bool leftNegative = false, rightNegative = false;
+	auto& a = toDigits(left, leftStorage, leftNegative);
+	auto& b = toDigits(right, rightStorage, rightNegative);
+
+	if (b.empty())
+		throw StoneException("divide by zero");
+	divideDigits(a, b, quotient, remainder);
+	return toValue(leftNegative != rightNegative, std::move(quotient));
+}
+
+Value BigInt::mod(const Value& left, const Value& right)
+{
+	Digits leftStorage, rightStorage, quotient, remainder;
+	bool leftNegative = false, rightNegative = false;
+	auto& a = toDigits(left, leftStorage, leftNegative);
+	auto& b = toDigits(right, rightStorage, rightNegative);
+
+	if (b.empty())
+		throw StoneException("divide by zero");
+	divideDigits(a, b, quotient, remainder);
+	return toValue(leftNegative, std::move(remainder));
+}
+
+Value BigInt::negate(const Value& value)
+{
+	Digits storage;
+	bool negative = false;
+	auto& digits = toDigits(value, storage, negative);
+
+	return toValue(!negative, Digits(digits));
+}
+
+int BigInt::compare(const Value& left, const Value& right)
+{
+	Digits leftStorage, rightStorage;
+	bool leftNegative = false, rightNegative = false;
+	auto& a = toDigits(left, leftStorage, leftNegative);
+	auto& b = toDigits(right, rightStorage, rightNegative);
+
+	if (leftNegative != rightNegative)
+		return leftNegative ? -1 : 1;
+	int ret = compareDigits(a, b);
+	return leftNegative ? -ret : ret;
+}
+NS_STONE_END
\ No newline at end of file
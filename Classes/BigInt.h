@@ -0,0 +1,90 @@
+#ifndef __Stone_BigInt_H__
+#define __Stone_BigInt_H__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "STObject.h"
+#include "Value.h"
+
+NS_STONE_BEGIN
+
+/*
+	⾫ɱ䣬ֵ2^32ƴӵλλ
+	ܷint64ĽǷINTEGERֻʱɴ
+*/
+class BigInt : public Object
+{
+public:
+	typedef std::vector<uint32_t> Digits;
+public:
+	//ʮַԴţصĶüΪ1
+	static BigInt* create(const std::string& text);
+	virtual ~BigInt();
+
+	bool isNegative() const { return _negative; }
+	const Digits& getDigits() const { return _digits; }
+	std::string toString() const;
+	double toDouble() const;
+	//ȡ64λ
+	int64_t toLong() const;
+	bool equals(const BigInt* other) const;
+public:
+	//㣬ܷint64ʱ
+	static Value add(const Value& left, const Value& right);
+	static Value subtract(const Value& left, const Value& right);
+	static Value multiply(const Value& left, const Value& right);
+	//һ0ȡ뱻ͬţΪ0
+	static Value divide(const Value& left, const Value& right);
+	static Value mod(const Value& left, const Value& right);
+	static Value negate(const Value& value);
+	static int compare(const Value& left, const Value& right);
+	//תΪValueܷint64ʱ
+	static Value toValue(bool negative, Digits&& digits);
+private:
+	BigInt(bool negative, Digits&& digits);
+private:
+	bool _negative;
+	Digits _digits;
+};
+
+//㣬ʱtrue
+inline bool addOverflow(int64_t left, int64_t right, int64_t* ret)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_add_overflow(left, right, ret);
+#else
+	if ((right > 0 && left > INT64_MAX - right) || (right < 0 && left < INT64_MIN - right))
+		return true;
+	*ret = left + right;
+	return false;
+#endif
+}
+
+inline bool subOverflow(int64_t left, int64_t right, int64_t* ret)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_sub_overflow(left, right, ret);
+#else
+	if ((right < 0 && left > INT64_MAX + right) || (right > 0 && left < INT64_MIN + right))
+		return true;
+	*ret = left - right;
+	return false;
+#endif
+}
+
+inline bool mulOverflow(int64_t left, int64_t right, int64_t* ret)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_mul_overflow(left, right, ret);
+#else
+	if (left > 0 ? (right > 0 ? left > INT64_MAX / right : right < INT64_MIN / left)
+		: (right > 0 ? left < INT64_MIN / right : (left != 0 && right < INT64_MAX / left)))
+		return true;
+	*ret = left * right;
+	return false;
+#endif
+}
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -0,0 +1,22 @@
+#ifndef __Stone_Cell_H__
+#define __Stone_Cell_H__
+
+#include "STObject.h"
+#include "Value.h"
+
+NS_STONE_BEGIN
+/*
+	հʱʹõĹԪ廷ͱհͨͬһ
+*/
+class Cell : public Object
+{
+public:
+	Cell() {}
+	Cell(const Value& v)
+		:value(v)
+	{}
+public:
+	Value value;
+};
+NS_STONE_END
+#endif
@@ -0,0 +1,83 @@
+#include <algorithm>
+
+#include "Channel.h"
+#include "StoneException.h"
+
+NS_STONE_BEGIN
+
+Channel::Channel(unsigned int capacity)
+	:_capacity(capacity)
+	,_closed(false)
+{
+}
+
+Channel::~Channel()
+{
+}
+
+void Channel::send(const Value& value)
+{
+	while (_buffer.size() >= _capacity && !_closed)
+		this->wait(_senders);
+	if (_closed)
+		throw StoneException("send on closed channel");
+
+	_buffer.push_back(value);
+	this->wakeOne(_receivers);
+}
+
+bool Channel::recv(Value& value)
+{
+	while (_buffer.empty() && !_closed)
+		this->wait(_receivers);
+	if (_buffer.empty())
+		return false;
+
+	value = std::move(_buffer.front());
+	_buffer.pop_front();
+	this->wakeOne(_senders);
+	return true;
+}
+
+void Channel::close()
+{
+	if (_closed)
+		return;
+	_closed = true;
+
+	TaskGroup* group = TaskGroup::getCurrent();
+	for (auto waiter : _senders)
+		group->wake(*waiter);
+	for (auto waiter : _receivers)
+		group->wake(*waiter);
+	_senders.clear();
+	_receivers.clear();
+}
+
+void Channel::wait(std::deque<TaskGroup::Waiter*>& queue)
+{
+	TaskGroup::Waiter waiter;
+	queue.push_back(&waiter);
+	try
+	{
+		TaskGroup::getCurrent()->park(waiter);
+	}
+	catch (...)
+	{
+		//ûбѣӶƳ
+		auto it = std::find(queue.begin(), queue.end(), &waiter);
+		if (it != queue.end())
+			queue.erase(it);
+		throw;
+	}
+}
+
+void Channel::wakeOne(std::deque<TaskGroup::Waiter*>& queue)
+{
+	if (queue.empty())
+		return;
+	TaskGroup::Waiter* waiter = queue.front();
+	queue.pop_front();
+	TaskGroup::getCurrent()->wake(*waiter);
+}
+NS_STONE_END
\ No newline at end of file
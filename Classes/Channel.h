@@ -0,0 +1,45 @@
+#ifndef __Stone_Channel_H__
+#define __Stone_Channel_H__
+
+#include <deque>
+
+#include "STObject.h"
+#include "Value.h"
+#include "TaskGroup.h"
+
+NS_STONE_BEGIN
+
+/*
+	н֮ͨ䴫ֵ
+	ʱsendȴʱrecvȴȴʱͷŽԼִ
+	вڳнʱУڲҪ
+	رպsend׳쳣recvȡʣֵ󷵻false
+*/
+class Channel : public Object
+{
+public:
+	Channel(unsigned int capacity);
+	virtual ~Channel();
+
+	void send(const Value& value);
+	//ȡһֵvalueرȡ󷵻falsevalue
+	bool recv(Value& value);
+	//رͨеȴ
+	void close();
+
+	unsigned int getCapacity() const { return _capacity; }
+	bool isClosed() const { return _closed; }
+private:
+	//queueϵȴֱѻ
+	void wait(std::deque<TaskGroup::Waiter*>& queue);
+	//queueеĵһȴ
+	void wakeOne(std::deque<TaskGroup::Waiter*>& queue);
+private:
+	std::deque<Value> _buffer;
+	unsigned int _capacity;
+	bool _closed;
+	std::deque<TaskGroup::Waiter*> _senders;
+	std::deque<TaskGroup::Waiter*> _receivers;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
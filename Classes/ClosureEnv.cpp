@@ -0,0 +1,123 @@
+#include "ClosureEnv.h"
+#include "Cell.h"
+#include "Upvalues.h"
+
+NS_STONE_BEGIN
+
+ClosureEnv::ClosureEnv(Upvalues* upvalues)
+	:_upvalues(upvalues)
+	,_cells(upvalues->getSize(), nullptr)
+	,_outer(nullptr)
+{
+	_upvalues->retain();
+}
+
+ClosureEnv::~ClosureEnv()
+{
+	for (auto cell : _cells)
+	{
+		if (cell != nullptr)
+			cell->release();
+	}
+	_cells.clear();
+
+	if (_outer != nullptr)
+		_outer->release();
+	_upvalues->release();
+}
+
+void ClosureEnv::setOuter(Environment* env)
+{
+	env->retain();
+	if (_outer != nullptr)
+	{
+		_outer->release();
+	}
+	_outer = env;
+}
+
+void ClosureEnv::setCell(unsigned int index, Cell* cell)
+{
+	cell->retain();
+	if (_cells[index] != nullptr)
+	{
+		_cells[index]->release();
+	}
+	_cells[index] = cell;
+}
+
+Environment* ClosureEnv::getOuter() const
+{
+	return _outer;
+}
+
+Environment* ClosureEnv::where(const std::string& name)
+{
+	int index = _upvalues->indexOf(name);
+	//Ѳñ
+	if (index >= 0 && _cells[index] != nullptr)
+		return this;
+	else if (_outer == nullptr)
+		return nullptr;
+	else
+		return _outer->where(name);
+}
+
+Cell* ClosureEnv::getCell(const std::string& name)
+{
+	int index = _upvalues->indexOf(name);
+
+	if (index < 0)
+		return nullptr;
+	return _cells[index];
+}
+
+Value* ClosureEnv::getUpvalue(unsigned int index)
+{
+	Cell* cell = _cells[index];
+
+	return cell != nullptr ? &cell->value : nullptr;
+}
+
+void ClosureEnv::putNew(const std::string& name, const Value& value)
+{
+	Cell* cell = this->getCell(name);
+
+	if (cell != nullptr)
+		cell->value = value;
+	else if (_outer != nullptr)
+		_outer->putNew(name, value);
+}
+
+void ClosureEnv::put(const std::string& name, const Value& value)
+{
+	Cell* cell = this->getCell(name);
+
+	if (cell != nullptr)
+		cell->value = value;
+	else if (_outer != nullptr)
+		_outer->put(name, value);
+}
+
+const Value* ClosureEnv::get(const std::string& name) const
+{
+	int index = _upvalues->indexOf(name);
+
+	if (index >= 0 && _cells[index] != nullptr)
+		return &_cells[index]->value;
+	else if (_outer != nullptr)
+		return _outer->get(name);
+	return nullptr;
+}
+
+Value* ClosureEnv::get(const std::string& name)
+{
+	int index = _upvalues->indexOf(name);
+
+	if (index >= 0 && _cells[index] != nullptr)
+		return &_cells[index]->value;
+	else if (_outer != nullptr)
+		return _outer->get(name);
+	return nullptr;
+}
+NS_STONE_END
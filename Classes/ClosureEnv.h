@@ -0,0 +1,44 @@
+#ifndef __Stone_ClosureEnv_H__
+#define __Stone_ClosureEnv_H__
+
+#include <vector>
+
+#include "Environment.h"
+
+NS_STONE_BEGIN
+
+class Cell;
+class Upvalues;
+
+/*
+	հֻհõɱɱֱӷʣ
+	㻷(һΪȫֻ)
+*/
+class ClosureEnv : public Environment
+{
+public:
+	ClosureEnv(Upvalues* upvalues);
+	virtual ~ClosureEnv();
+
+	void setOuter(Environment* env);
+	//ӦĹԪ
+	void setCell(unsigned int index, Cell* cell);
+public:
+	virtual Environment* getOuter() const;
+	virtual Environment* where(const std::string& name);
+	virtual Cell* getCell(const std::string& name);
+	virtual Value* getUpvalue(unsigned int index);
+
+	//հ±δı㻷
+	virtual void putNew(const std::string& name, const Value& value);
+	virtual void put(const std::string& name, const Value& value);
+	virtual const Value* get(const std::string& name) const;
+	virtual Value* get(const std::string& name);
+private:
+	Upvalues* _upvalues;
+	//ɱһһӦδΪnullptr
+	std::vector<Cell*> _cells;
+	Environment* _outer;
+};
+NS_STONE_END
+#endif
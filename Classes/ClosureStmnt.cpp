@@ -3,16 +3,25 @@
 #include "Token.h"
 #include "ParameterList.h"
 #include "BlockStmnt.h"
+#include "Upvalues.h"
+#include "FrameLayout.h"
 #include "Visitor.h"
 
 NS_STONE_BEGIN
 ClosureStmnt::ClosureStmnt(const std::vector<ASTree*>& list)
 	:ASTList(list)
+	,_upvalues(nullptr)
+	,_layout(nullptr)
+	,_generator(false)
 {
 }
 
 ClosureStmnt::~ClosureStmnt()
 {
+	if (_upvalues != nullptr)
+		_upvalues->release();
+	if (_layout != nullptr)
+		_layout->release();
 }
 
 ParameterList* ClosureStmnt::getParameters() const
@@ -25,6 +34,33 @@ BlockStmnt* ClosureStmnt::getBody() const
 	return static_cast<BlockStmnt*>(getChild(1));
 }
 
+Upvalues* ClosureStmnt::getUpvalues() const
+{
+	return _upvalues;
+}
+
+void ClosureStmnt::setUpvalues(Upvalues* upvalues)
+{
+	upvalues->retain();
+	if (_upvalues != nullptr)
+		_upvalues->release();
+	_upvalues = upvalues;
+}
+
+FrameLayout* ClosureStmnt::getFrameLayout() const
+{
+	return _layout;
+}
+
+void ClosureStmnt::setFrameLayout(FrameLayout* layout)
+{
+	if (layout != nullptr)
+		layout->retain();
+	if (_layout != nullptr)
+		_layout->release();
+	_layout = layout;
+}
+
 void ClosureStmnt::accept(Visitor* v, Environment* env)
 {
 	v->visit(this, env);
@@ -7,6 +7,8 @@ NS_STONE_BEGIN
 
 class ParameterList;
 class BlockStmnt;
+class Upvalues;
+class FrameLayout;
 class Visitor;
 class Environment;
 
@@ -20,9 +22,22 @@ public:
 	ParameterList* getParameters() const;
 	//ȡ
 	BlockStmnt* getBody() const;
+	//ȡɱδΪnullptr
+	Upvalues* getUpvalues() const;
+	void setUpvalues(Upvalues* upvalues);
+	//ȡջ֣֡ûΪnullptr
+	FrameLayout* getFrameLayout() const;
+	void setFrameLayout(FrameLayout* layout);
+	//Ƿyieldʱ
+	bool isGenerator() const { return _generator; }
+	void setGenerator(bool generator) { _generator = generator; }
 public:
 	virtual void accept(Visitor* v, Environment* env);
 	virtual std::string toString() const;
+private:
+	Upvalues* _upvalues;
+	FrameLayout* _layout;
+	bool _generator;
 };
 NS_STONE_END
 #endif
\ No newline at end of file
@@ -0,0 +1,119 @@
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+//AddressSanitizerҪ֪ջлЭջ׳쳣ʱ
+#if defined(__SANITIZE_ADDRESS__) && !defined(_WIN32)
+#include <sanitizer/common_interface_defs.h>
+#define STONE_ASAN_FIBER
+#endif
+
+#include "Coroutine.h"
+#include "StoneException.h"
+
+NS_STONE_BEGIN
+
+#ifndef _WIN32
+//makecontextֻܴint״лǰͨЭ
+static thread_local Coroutine* s_starting = nullptr;
+#endif
+
+Coroutine::Coroutine(const Body& body, size_t stackSize)
+	:_body(body)
+	,_finished(false)
+{
+#ifdef _WIN32
+	_caller = nullptr;
+	_handle = CreateFiber(stackSize, &Coroutine::entry, this);
+	if (_handle == nullptr)
+		throw StoneException("failed to create coroutine");
+#else
+	size_t page = sysconf(_SC_PAGESIZE);
+	_stackSize = stackSize + page;
+	void* stack = mmap(nullptr, _stackSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (stack == MAP_FAILED)
+		throw StoneException("failed to create coroutine");
+	_stack = static_cast<char*>(stack);
+	//ջ͵ַ͵һҳΪҳ
+	mprotect(_stack, page, PROT_NONE);
+
+	getcontext(&_context);
+	_context.uc_stack.ss_sp = _stack + page;
+	_context.uc_stack.ss_size = stackSize;
+	_context.uc_link = nullptr;
+	_callerStack = nullptr;
+	_callerStackSize = 0;
+	makecontext(&_context, &Coroutine::entry, 0);
+#endif
+}
+
+Coroutine::~Coroutine()
+{
+#ifdef _WIN32
+	DeleteFiber(_handle);
+#else
+	munmap(_stack, _stackSize);
+#endif
+}
+
+void Coroutine::resume()
+{
+#ifdef _WIN32
+	//̵߳һлǰҪתΪ˳
+	if (!IsThreadAFiber())
+		ConvertThreadToFiber(nullptr);
+	_caller = GetCurrentFiber();
+	SwitchToFiber(_handle);
+#else
+	s_starting = this;
+#ifdef STONE_ASAN_FIBER
+	void* fakeStack = nullptr;
+	__sanitizer_start_switch_fiber(&fakeStack, _context.uc_stack.ss_sp, _context.uc_stack.ss_size);
+	swapcontext(&_caller, &_context);
+	__sanitizer_finish_switch_fiber(fakeStack, nullptr, nullptr);
+#else
+	swapcontext(&_caller, &_context);
+#endif
+#endif
+}
+
+void Coroutine::suspend()
+{
+	//ָһ߳У֮ʹлǰȡֲ߳̾
+#ifdef _WIN32
+	SwitchToFiber(_caller);
+#elif defined(STONE_ASAN_FIBER)
+	void* fakeStack = nullptr;
+	//Э̲л
+	__sanitizer_start_switch_fiber(_finished ? nullptr : &fakeStack, _callerStack, _callerStackSize);
+	swapcontext(&_context, &_caller);
+	__sanitizer_finish_switch_fiber(fakeStack, &_callerStack, &_callerStackSize);
+#else
+	swapcontext(&_context, &_caller);
+#endif
+}
+
+void Coroutine::run()
+{
+	_body();
+	_finished = true;
+	//ٻָջʱͷ
+	this->suspend();
+}
+
+#ifdef _WIN32
+void CALLBACK Coroutine::entry(void* param)
+{
+	static_cast<Coroutine*>(param)->run();
+}
+#else
+void Coroutine::entry()
+{
+	Coroutine* coroutine = s_starting;
+#ifdef STONE_ASAN_FIBER
+	__sanitizer_finish_switch_fiber(nullptr, &coroutine->_callerStack, &coroutine->_callerStackSize);
+#endif
+	coroutine->run();
+}
+#endif
+NS_STONE_END
\ No newline at end of file
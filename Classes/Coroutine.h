@@ -0,0 +1,62 @@
+#ifndef __Stone_Coroutine_H__
+#define __Stone_Coroutine_H__
+
+#include <functional>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <ucontext.h>
+#endif
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+/*
+	ջЭ̣Լջִк壬ȹ
+	resumeлЭ̣Эеsuspendߺ巵غصresume
+	һ߳лָҲһЭлָ(Ƕ)
+	е쳣׳Э֮
+*/
+class Coroutine
+{
+public:
+	typedef std::function<void()> Body;
+public:
+	//ջֻʹõʱռڴ
+	Coroutine(const Body& body, size_t stackSize);
+	virtual ~Coroutine();
+
+	//еһsuspendߺ巵
+	void resume();
+	//ֻЭеãָѾһ߳
+	void suspend();
+	//ѷأresume
+	bool isFinished() const { return _finished; }
+private:
+	void run();
+#ifdef _WIN32
+	static void CALLBACK entry(void* param);
+#else
+	static void entry();
+#endif
+private:
+	Body _body;
+	bool _finished;
+#ifdef _WIN32
+	void* _handle;
+	void* _caller;
+#else
+	ucontext_t _context;
+	ucontext_t _caller;
+	//ջ׼һҳҳջʱֱӳ
+	char* _stack;
+	size_t _stackSize;
+	//resumeջֻAddressSanitizerʹ
+	const void* _callerStack;
+	size_t _callerStackSize;
+#endif
+};
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -3,16 +3,25 @@
 #include "Token.h"
 #include "ParameterList.h"
 #include "BlockStmnt.h"
+#include "Upvalues.h"
+#include "FrameLayout.h"
 #include "Visitor.h"
 
 NS_STONE_BEGIN
 DefStmnt::DefStmnt(const std::vector<ASTree*>& list)
 	:ASTList(list)
+	,_upvalues(nullptr)
+	,_layout(nullptr)
+	,_generator(false)
 {
 }
 
 DefStmnt::~DefStmnt()
 {
+	if (_upvalues != nullptr)
+		_upvalues->release();
+	if (_layout != nullptr)
+		_layout->release();
 }
 
 std::string DefStmnt::getName() const
@@ -30,6 +39,33 @@ BlockStmnt* DefStmnt::getBody() const
 	return static_cast<BlockStmnt*>(getChild(2));
 }
 
+Upvalues* DefStmnt::getUpvalues() const
+{
+	return _upvalues;
+}
+
+void DefStmnt::setUpvalues(Upvalues* upvalues)
+{
+	upvalues->retain();
+	if (_upvalues != nullptr)
+		_upvalues->release();
+	_upvalues = upvalues;
+}
+
+FrameLayout* DefStmnt::getFrameLayout() const
+{
+	return _layout;
+}
+
+void DefStmnt::setFrameLayout(FrameLayout* layout)
+{
+	if (layout != nullptr)
+		layout->retain();
+	if (_layout != nullptr)
+		_layout->release();
+	_layout = layout;
+}
+
 void DefStmnt::accept(Visitor* v, Environment* env)
 {
 	v->visit(this, env);
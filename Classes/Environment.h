@@ -6,9 +6,12 @@
 #include "STObject.h"
 #include "Value.h"
 #include "NativeFunction.h"
+#include "NativeBinding.h"
 
 NS_STONE_BEGIN
 
+class Cell;
+
 class Environment: public Object
 {
 public:
@@ -24,9 +27,33 @@ public:
 		this->putNew(name, Value(function));
 		function->release();
 	}
+	//ӿٵõıغλô룬modeΪ׸Ĵ뷽ʽ
+	void putNative(const std::string& name, const fastNativeFunc& callback, int len, NativeFunction::ArgMode mode = NativeFunction::ArgMode::VALUE)
+	{
+		NativeFunction* function = new NativeFunction(len, callback, this, mode);
+		this->putNew(name, Value(function));
+		function->release();
+	}
+	//C++lambda󣬲ͷֵԶת
+	template<typename F>
+	void bindNative(const std::string& name, F func)
+	{
+		this->putNative(name, makeNative(func), CallableTraits<F>::arity);
+	}
 	//ȡ
 	virtual const Value* get(const std::string& name) const = 0;
 	virtual Value* get(const std::string& name) = 0;
+
+	//ȡ㻷
+	virtual Environment* getOuter() const = 0;
+	//ҰñӦĻظû
+	virtual Environment* where(const std::string& name) = 0;
+	//ȡڱĹԪڱհ񣬲򷵻nullptr
+	virtual Cell* getCell(const std::string& name) = 0;
+	//ȡհıǱհ򷵻nullptr
+	virtual Value* getUpvalue(unsigned int index) { return nullptr; }
+	//ջֵ֡ȡջ֡߱δֵ򷵻nullptr
+	virtual Value* getLocal(unsigned int index) { return nullptr; }
 };
 NS_STONE_END
 #endif
\ No newline at end of file
@@ -1,3 +1,7 @@
+#include <cmath>
+#include <climits>
+#include <algorithm>
+
 #include "EvalVisitor.h"
 #include "Token.h"
 #include "Environment.h"
@@ -13,6 +17,8 @@
 #include "BlockStmnt.h"
 #include "IfStmnt.h"
 #include "WhileStmnt.h"
+#include "ForStmnt.h"
+#include "YieldStmnt.h"
 #include "PrimaryExpr.h"
 #include "Postfix.h"
 #include "Arguments.h"
@@ -25,20 +31,44 @@
 #include "ScriptFunction.h"
 #include "ArrayLiteral.h"
 #include "ArrayRef.h"
+#include "MapLiteral.h"
+#include "PersistentVector.h"
+#include "SliceRef.h"
+#include "ArrayView.h"
+#include "StringBuilder.h"
+#include "BigInt.h"
+#include "PackedArray.h"
+#include "VectorKernels.h"
+#include "FreeVarVisitor.h"
+#include "Upvalues.h"
+#include "ClosureEnv.h"
+#include "Cell.h"
+#include "FrameLayout.h"
+#include "StackEnv.h"
+#include "NativeFunction.h"
+#include "TaskGroup.h"
+#include "Generator.h"
+
+//ٵʱջϵĲʱڶϷ
+#define MAX_INLINE_ARGS 8
+//Ӻ󲻳óȵֱַӸƣʹStringBuilder
+#define SHORT_STRING_LENGTH 64
 
 NS_STONE_BEGIN
 EvalVisitor::EvalVisitor()
-	:result(nullptr)
-	,_allocated(false)
+	:result(&_register)
+	,_frameDepth(0)
+	,_concurrent(false)
+	,_generator(nullptr)
+	,_ticks(0)
 {
 }
 
 EvalVisitor::~EvalVisitor()
 {
-	if (_allocated)
-	{
-		delete result;
-	}
+	for (auto frame : _frames)
+		frame->release();
+	_frames.clear();
 }
 
 void EvalVisitor::visit(ASTree* t, Environment* env)
@@ -55,8 +85,7 @@ void EvalVisitor::visit(ASTLeaf* t, Environment* env)
 
 void EvalVisitor::visit(NumberLiteral* t, Environment* env)
 {
-	//ʱֻ֧
-	this->setResult(t->getToken()->asInt());
+	this->setResult(t->getValue());
 }
 
 void EvalVisitor::visit(StringLiteral* t, Environment* env)
@@ -66,10 +95,19 @@ void EvalVisitor::visit(StringLiteral* t, Environment* env)
 
 void EvalVisitor::visit(Name* t, Environment* env)
 {
+	//ջ֡еıͱհıֱӰ
+	Value* value = this->getLocal(t, env);
+	if (value == nullptr)
+		value = this->getUpvalue(t, env);
+	if (value != nullptr)
+	{
+		this->setResult(value);
+		return;
+	}
 	//ȡ
 	auto name = t->getName();
 	//ȡӦֵ
-	Value* value = env->get(name);
+	value = env->get(name);
 	if (value == nullptr)
 	{
 		throw StoneException("undefined name: " + name, t);
@@ -84,10 +122,18 @@ void EvalVisitor::visit(NegativeExpr* t, Environment* env)
 {
 	//
 	t->getOperand()->accept(this, env);
-	//TODO:ֻͲʹø
-	if (this->result->getType() == Value::Type::INTEGER)
+	//ֵֻʹø
+	if (this->result->getType() == Value::Type::INTEGER && this->result->asLong() != INT64_MIN)
+	{
+		this->setResult(Value(-this->result->asLong()));
+	}
+	else if (this->result->isInteger())
 	{
-		this->setResult(-this->result->asInt());
+		this->setResult(BigInt::negate(*this->result));
+	}
+	else if (this->result->isNumber())
+	{
+		this->setResult(Value(-this->result->asDouble()));
 	}
 	else
 	{
@@ -118,25 +164,30 @@ void EvalVisitor::visit(BinaryExpr* t, Environment* env)
 			{
 				//ó
 				ArrayRef* ref = static_cast<ArrayRef*>(primary->getChild(primary->getNumChildren() - 1));
+				this->checkWritable(primary, env);
 				ref->getIndex()->accept(this, env);
-
-				if (this->result->getType() == Value::Type::INTEGER)
+				Value index = *this->result;
+				//ȡ飬ԪصĶȡƣֱдԭ
+				this->evalSubExpr(primary, env, 1);
+				//־ûµİ汾滻ԭİ汾
+				if (this->result->getType() == Value::Type::PERSISTENT_VECTOR)
 				{
-					auto index = this->result->asInt();
-					//ȡ
-					this->evalSubExpr(primary, env, 1);
-					std::vector<Value>& list = this->result->asValueVector();
-					list[index] = right;
-					ret = true;
-					//ֵ
-					this->setResult(right);
+					this->getElement(ref, *this->result, index, false);
+					PersistentVector* vector = this->result->asPersistentVector()->assoc(index.asInt(), right);
+					*this->result = Value(vector);
+					vector->release();
 				}
+				else
+					*this->getElement(ref, *this->result, index, true) = right;
+				ret = true;
+				//ֵ
+				this->setResult(right);
 			}
 		}
 		//ӵ
 		else
 		{
-			env->put(left->getName(), right);
+			this->assign(left, right, env);
 			ret = true;
 		}
 		if (!ret)
@@ -152,9 +203,8 @@ void EvalVisitor::visit(BinaryExpr* t, Environment* env)
 		Value right = *this->result;
 
 		//ֵ
-		Value value = this->computeOp(t, left, op, right);
 		//ֵ
-		this->setResult(value);
+		this->setResult(this->computeOp(t, left, op, right));
 	}
 }
 
@@ -197,6 +247,7 @@ void EvalVisitor::visit(WhileStmnt* t, Environment* env)
 	Value value;
 	do 
 	{
+		this->checkYield();
 		//ж
 		t->getCondition()->accept(this, env);
 		//˳
@@ -205,10 +256,60 @@ void EvalVisitor::visit(WhileStmnt* t, Environment* env)
 		//ִ
 		t->getBody()->accept(this, env);
 		//ݴ淵ֵ
-		value = this->result;
+		value = *this->result;
 
 	} while (1);
-	this->setResult(value);
+	this->setResult(std::move(value));
+}
+
+void EvalVisitor::visit(ForStmnt* t, Environment* env)
+{
+	t->getSource()->accept(this, env);
+	//ǿʼʱĿգѭ޸ԭʱӰ
+	Value source;
+	if (this->isOwned())
+		source = std::move(_register);
+	//תΪͼ洢ԭ޸ʱŸ
+	//б̶ܱ߳ȡԭתֱӸ
+	else if (!_concurrent && this->result->getType() == Value::Type::VECTOR)
+	{
+		this->result->asArrayView();
+		source = *this->result;
+	}
+	else
+		source = *this->result;
+	Value value;
+	Value item;
+
+	if (source.getType() == Value::Type::GENERATOR)
+	{
+		Generator* generator = source.asGenerator();
+		//ÿֻȡһֵ
+		while (generator->next(item))
+		{
+			this->checkYield();
+			this->assign(t->getName(), item, env);
+			t->getBody()->accept(this, env);
+			value = *this->result;
+		}
+	}
+	else
+	{
+		const Value* data = nullptr;
+		unsigned int size = 0;
+
+		if (!source.getElements(data, size))
+			throw StoneException("bad for source", t);
+
+		for (unsigned int i = 0; i < size; i++)
+		{
+			this->checkYield();
+			this->assign(t->getName(), data[i], env);
+			t->getBody()->accept(this, env);
+			value = *this->result;
+		}
+	}
+	this->setResult(std::move(value));
 }
 
 void EvalVisitor::visit(PrimaryExpr* t, Environment* env)
@@ -224,31 +325,55 @@ void EvalVisitor::visit(Postfix* t, Environment* env)
 void EvalVisitor::visit(Arguments* t, Environment* env)
 {
 	Function* function = this->result->asFunction();
-	//ͬʧ
-	if (t->getSize() != function->getParamSize())
-		throw StoneException("bad number of arguments", t);
-
-	//һµĻ
-	Environment* newEnv = function->makeEnv();
-	//ͶӦֵ
-	for (int i = 0; i < t->getNumChildren(); i++)
+	//һεõĺͬ¼鲢ɲ󶨷ʽ
+	if (!t->isCached(function))
 	{
-		auto args = t->getChild(i);
-		//ȼ
-		args->accept(this, env);
-		//ӱ
-		newEnv->putNew(function->getParamName(i), *this->result);
+		//ͬʧ
+		if (t->getSize() != function->getParamSize())
+			throw StoneException("bad number of arguments", t);
+		//вд빲Ļ棬ֱӰ͵
+		if (_concurrent)
+		{
+			NativeFunction* native = dynamic_cast<NativeFunction*>(function);
+			if (native != nullptr && native->isFast())
+				this->callNative(t, native, env);
+			else if (function->getFrameLayout() != nullptr)
+				this->callWithFrame(t, function, function->getFrameLayout(), env);
+			else
+				this->callWithEnv(t, function, env, false);
+			return;
+		}
+		t->updateCache(function);
 	}
-	//ִк
-	function->execute(this, newEnv);
-	//ͷŻ
-	newEnv->release();
+	//ٵõıغλô
+	NativeFunction* native = t->getCachedNative();
+	if (native != nullptr)
+	{
+		this->callNative(t, native, env);
+		return;
+	}
+	//ûݣʹøõջ֡
+	FrameLayout* layout = t->getCachedLayout();
+	if (layout != nullptr)
+	{
+		this->callWithFrame(t, function, layout, env);
+		return;
+	}
+	this->callWithEnv(t, function, env, true);
 }
 
 void EvalVisitor::visit(DefStmnt* t, Environment* env)
 {
+	//״ִʱɱ
+	if (t->getUpvalues() == nullptr)
+	{
+		FreeVarVisitor analyzer;
+		t->accept(&analyzer, env);
+	}
 	//ֱڱFunction
-	Function* function = new ScriptFunction(t->getParameters(), t->getBody(), env);
+	Environment* closureEnv = this->makeClosureEnv(t->getUpvalues(), env);
+	Function* function = new ScriptFunction(t->getParameters(), t->getBody(), closureEnv, t->getFrameLayout(), t->isGenerator());
+	closureEnv->release();
 	Value value = Value(function);
 
 	env->putNew(t->getName(), value);
@@ -259,12 +384,36 @@ void EvalVisitor::visit(DefStmnt* t, Environment* env)
 
 void EvalVisitor::visit(ClosureStmnt* t, Environment* env)
 {
-	Function* closure = new ScriptFunction(t->getParameters(), t->getBody(), env);
+	//״ִʱɱ
+	if (t->getUpvalues() == nullptr)
+	{
+		FreeVarVisitor analyzer;
+		t->accept(&analyzer, env);
+	}
+	//ֻõı廷
+	Environment* closureEnv = this->makeClosureEnv(t->getUpvalues(), env);
+	Function* closure = new ScriptFunction(t->getParameters(), t->getBody(), closureEnv, t->getFrameLayout(), t->isGenerator());
+	closureEnv->release();
 	closure->autorelease();
 	//ֵ
 	this->setResult(closure);
 }
 
+void EvalVisitor::visit(YieldStmnt* t, Environment* env)
+{
+	t->getValue()->accept(this, env);
+	Value value = *this->result;
+
+	if (_generator == nullptr)
+		throw StoneException("yield outside generator", t);
+	//ֵڱʾܲ
+	if (value.isNull())
+		throw StoneException("cannot yield null", t);
+	//ڼresultܱ޸
+	_generator->yield(value);
+	this->setResult(Value::Null);
+}
+
 void EvalVisitor::visit(ArrayLiteral* t, Environment* env)
 {
 	std::vector<Value> list;
@@ -283,83 +432,186 @@ void EvalVisitor::visit(ArrayLiteral* t, Environment* env)
 
 void EvalVisitor::visit(ArrayRef* t, Environment* env)
 {
-	//ʱ
-	std::vector<Value> list = this->result->asValueVector();
-	//ȡ
-	t->getIndex()->accept(this, env);
-	Value index = *this->result;
+	//Ҫһ㣬evalSubExpr
+}
 
-	//Ŀǰ֧
-	if (index.getType() == Value::Type::INTEGER)
+void EvalVisitor::visit(SliceRef* t, Environment* env)
+{
+	//Ҫһ㣬evalSubExpr
+}
+
+void EvalVisitor::readElement(PrimaryExpr* t, ArrayRef* ref, Environment* env, int nest, ValueVector* path)
+{
+	//иʱ¼Ĳ·
+	ValueVector local;
+	if (path == nullptr && !ref->isPure())
+		path = &local;
+	//Ҽ㣬ȼ
+	this->evalSubExpr(t, env, nest + 1, path);
+	//ΪʱֵʱȡȨʱ
+	Value* array = this->result;
+	Value temp;
+	bool owned = this->isOwned();
+	if (owned)
 	{
-		this->setResult(list.at(index.asInt()));
+		temp = std::move(_register);
+		array = &temp;
 	}
+	ref->getIndex()->accept(this, env);
+	Value index = *this->result;
+	//ڱУʱ޸˱ʹԭĵַʧЧ²
+	if (!owned && !ref->isPure())
+		array = this->relocate(t, env, *path, temp, owned);
+	if (path != nullptr)
+		path->push_back(index);
+
+	Value* element = array != nullptr ? this->getElement(ref, *array, index, false) : nullptr;
+	//mapвڸü
+	if (element == nullptr)
+		this->setResult(Value::Null);
+	//־ûͼԪǹģܱ޸ģƳ
+	else if (array->getType() == Value::Type::PERSISTENT_VECTOR || array->getType() == Value::Type::ARRAY_VIEW)
+		this->setResult(*element);
+	//ֱеԪأʱƶ
+	else if (owned)
+		this->setResult(std::move(*element));
 	else
+		this->setResult(element);
+}
+
+void EvalVisitor::sliceArray(PrimaryExpr* t, SliceRef* ref, Environment* env, int nest)
+{
+	//иʱ¼Ĳ·
+	ValueVector path;
+	this->evalSubExpr(t, env, nest + 1, ref->isPure() ? nullptr : &path);
+	//ΪʱֵʱȡȨʱ
+	Value* array = this->result;
+	Value temp;
+	bool owned = this->isOwned();
+	if (owned)
 	{
-		throw StoneException("bad array access", t);
+		temp = std::move(_register);
+		array = &temp;
 	}
+	//ʡʱΪĿͷͽβ
+	int low = 0;
+	int high = -1;
+	if (ref->getLow() != nullptr)
+		high = low = this->evalSliceBound(ref, ref->getLow(), env);
+	if (ref->getHigh() != nullptr)
+		high = this->evalSliceBound(ref, ref->getHigh(), env);
+	if (!owned && !ref->isPure())
+		array = this->relocate(t, env, path, temp, owned);
+
+	if (array == nullptr || (array->getType() != Value::Type::VECTOR && array->getType() != Value::Type::ARRAY_VIEW))
+		throw StoneException("bad slice", ref);
+	//б̶ܱ߳ȡԭתΪͼƺƬ
+	if (_concurrent && !owned && array->getType() == Value::Type::VECTOR)
+	{
+		temp = *array;
+		array = &temp;
+	}
+	//ԭתΪͼƬ洢
+	ArrayView* view = array->asArrayView();
+	if (ref->getHigh() == nullptr)
+		high = view->size();
+	if (low > high || high > (int)view->size())
+		throw StoneException("slice out of range", ref);
+
+	ArrayView* slice = view->slice(low, high);
+	this->setResult(Value(slice));
+	slice->release();
+}
+
+void EvalVisitor::visit(MapLiteral* t, Environment* env)
+{
+	Value map = Value(ValueMap());
+	auto& table = map.asValueMap();
+
+	table.reserve(t->getSize());
+	for (unsigned int i = 0; i < t->getSize(); i++)
+	{
+		auto key = t->getKey(i);
+		key->accept(this, env);
+		if (!this->result->isString() && this->result->getType() != Value::Type::INTEGER)
+			throw StoneException("bad map key", key);
+		std::string name = this->result->asString();
+		//ֵ
+		t->getValue(i)->accept(this, env);
+		table[name] = *this->result;
+	}
+	this->setResult(std::move(map));
 }
 
 void EvalVisitor::setResult(int value)
 {
-	Value v = Value(value);
-	this->setResult(v);
+	_register = value;
+	result = &_register;
 }
 
 void EvalVisitor::setResult(const std::string& value)
 {
-	Value v = Value(value);
-	this->setResult(v);
+	_register = value;
+	result = &_register;
 }
 
 void EvalVisitor::setResult(const std::vector<Value>& value)
 {
-	Value v = Value(value);
-	this->setResult(v);
+	_register = value;
+	result = &_register;
 }
 
 void EvalVisitor::setResult(Function* value)
 {
-	Value v = Value(value);
-	this->setResult(v);
+	_register = value;
+	result = &_register;
 }
 
 void EvalVisitor::setResult(const Value& value)
 {
-	if (!_allocated)
-	{
-		result = new Value(value);
-		_allocated = true;
-	}
-	else
-	{
-		*result = value;
-	}
+	_register = value;
+	result = &_register;
+}
+
+void EvalVisitor::setResult(Value&& value)
+{
+	_register = std::move(value);
+	result = &_register;
 }
 
 void EvalVisitor::setResult(Value* value)
 {
-	if (_allocated)
-	{
-		delete result;
-		result = nullptr;
-		_allocated = false;
-	}
+	//ֻãĴеֵһд
 	result = value;
 }
 //---------------------------------BinaryExpr---------------------------
 Value EvalVisitor::computeOp(ASTree* t, const Value& left, const std::string& op, const Value& right)
 {
 	Value value;
-	//TODO:Ŀǰ֧
+	//֮ж
 	if (left.getType() == Value::Type::INTEGER && right.getType() == Value::Type::INTEGER)
 	{
-		value = this->computeNumber(t, left.asInt(), op, right.asInt());
+		value = this->computeNumber(t, left.asLong(), op, right.asLong());
+	}
+	//һΪ
+	else if (left.isInteger() && right.isInteger())
+	{
+		value = this->computeBigInt(t, left, op, right);
+	}
+	//һΪʱΪdouble
+	else if (left.isNumber() && right.isNumber())
+	{
+		value = this->computeNumber(t, left.asDouble(), op, right.asDouble());
+	}
+	//鰴Ԫ㣬==ȻȽ
+	else if ((left.isArray() || right.isArray()) && "==" != op)
+	{
+		value = this->computeArray(t, left, op, right);
 	}
 	//תΪַ
 	else if ("+" == op)
 	{
-		value = Value(left.asString() + right.asString());
+		value = this->concat(left, right);
 	}
 	else if ("==" == op)
 	{
@@ -373,37 +625,299 @@ Value EvalVisitor::computeOp(ASTree* t, const Value& left, const std::string& op
 	return value;
 }
 
-int EvalVisitor::computeNumber(ASTree* t, int left, const std::string& op, int right)
+//ԪضֵʱĻм㣬޷߿ʱfalse
+static bool computePacked(const Value* leftData, unsigned int leftSize, const std::string& op,
+	const Value* rightData, unsigned int rightSize, unsigned int size, Value& ret)
 {
+	PackedArray left, right;
+	auto& kernels = VectorKernels::getInstance();
+
+	left.pack(leftData, leftSize);
+	right.pack(rightData, rightSize);
+	if (left.getKind() == PackedArray::Kind::OTHER || right.getKind() == PackedArray::Kind::OTHER)
+		return false;
+
+	bool isLong = left.getKind() == PackedArray::Kind::LONG && right.getKind() == PackedArray::Kind::LONG;
+	uint64_t maxAbs = std::max(left.getMaxAbs(), right.getMaxAbs());
+	//㲻Ϊ0
+	if (isLong)
+	{
+		if (("+" == op || "-" == op) && !PackedArray::fitsLong(maxAbs, 2, 1))
+			return false;
+		if ("*" == op && !PackedArray::fitsLong(left.getMaxAbs(), right.getMaxAbs(), 1))
+			return false;
+		if ("/" == op || "%" == op)
+		{
+			const int64_t* divisor = right.getLongs();
+			if (left.getMaxAbs() > (uint64_t)INT64_MAX || std::find(divisor, divisor + rightSize, 0) != divisor + rightSize)
+				return false;
+		}
+	}
+	else
+	{
+		left.promote();
+		right.promote();
+	}
+	left.broadcast(size);
+	right.broadcast(size);
+	//ȽϵĽΪ01
+	if ("<" == op || ">" == op)
+	{
+		ret = Value(ValueVector());
+		auto& list = ret.asValueVector();
+		bool less = "<" == op;
+
+		list.reserve(size);
+		for (unsigned int i = 0; i < size; i++)
+		{
+			bool result = isLong ? (less ? left.getLongs()[i] < right.getLongs()[i] : left.getLongs()[i] > right.getLongs()[i])
+				: (less ? left.getDoubles()[i] < right.getDoubles()[i] : left.getDoubles()[i] > right.getDoubles()[i]);
+			list.push_back(Value(result ? 1 : 0));
+		}
+		return true;
+	}
+	if (isLong)
+	{
+		int64_t* a = left.getLongs();
+		const int64_t* b = right.getLongs();
+
+		if ("+" == op)
+			kernels.addLong(a, b, size);
+		else if ("-" == op)
+			kernels.subLong(a, b, size);
+		else if ("*" == op)
+			kernels.multiplyLong(a, b, size);
+		else if ("/" == op)
+		{
+			for (unsigned int i = 0; i < size; i++)
+				a[i] /= b[i];
+		}
+		else if ("%" == op)
+		{
+			for (unsigned int i = 0; i < size; i++)
+				a[i] %= b[i];
+		}
+		else
+			return false;
+	}
+	else
+	{
+		double* a = left.getDoubles();
+		const double* b = right.getDoubles();
+
+		if ("+" == op)
+			kernels.addDouble(a, b, size);
+		else if ("-" == op)
+			kernels.subDouble(a, b, size);
+		else if ("*" == op)
+			kernels.multiplyDouble(a, b, size);
+		else if ("/" == op)
+			kernels.divideDouble(a, b, size);
+		else if ("%" == op)
+		{
+			for (unsigned int i = 0; i < size; i++)
+				a[i] = std::fmod(a[i], b[i]);
+		}
+		else
+			return false;
+	}
+	ret = left.toValue();
+	return true;
+}
+
+Value EvalVisitor::computeArray(ASTree* t, const Value& left, const std::string& op, const Value& right)
+{
+	//ֻһԪأһߵÿԪ
+	const Value* leftData = &left;
+	const Value* rightData = &right;
+	unsigned int leftSize = 1, rightSize = 1;
+
+	if (left.isArray())
+		left.getElements(leftData, leftSize);
+	if (right.isArray())
+		right.getElements(rightData, rightSize);
+	//Ϊ1ͬԹ㲥
+	if (leftSize != rightSize && leftSize != 1 && rightSize != 1)
+		throw StoneException("array size mismatch", t);
+	unsigned int size = leftSize == 1 ? rightSize : leftSize;
+
+	Value value;
+	if (computePacked(leftData, leftSize, op, rightData, rightSize, size, value))
+		return value;
+	//Ԫؼ㣬ԪΪʱݹ
+	value = Value(ValueVector());
+	auto& list = value.asValueVector();
+
+	list.reserve(size);
+	for (unsigned int i = 0; i < size; i++)
+		list.push_back(this->computeOp(t, leftData[leftSize == 1 ? 0 : i], op, rightData[rightSize == 1 ? 0 : i]));
+	return value;
+}
+
+//ȡַݣֵջϵcharsתתtext
+static void getText(const Value& value, char* chars, std::string& text, const char*& data, size_t& size)
+{
+	if (value.getChars(data, size))
+		return;
+	if (value.getType() == Value::Type::BIG_INTEGER)
+	{
+		text = value.asString();
+		data = text.data();
+		size = text.size();
+		return;
+	}
+	data = chars;
+	size = value.toChars(chars, NUMBER_BUFFER_SIZE);
+}
+
+Value EvalVisitor::concat(const Value& left, const Value& right)
+{
+	char leftChars[NUMBER_BUFFER_SIZE], rightChars[NUMBER_BUFFER_SIZE];
+	std::string leftText, rightText;
+	const char* leftData = nullptr;
+	const char* rightData = nullptr;
+	size_t leftSize = 0, rightSize = 0;
+
+	getText(left, leftChars, leftText, leftData, leftSize);
+	getText(right, rightChars, rightText, rightData, rightSize);
+	//Ѿɵַ׷ӵ仺
+	StringBuilder* builder = nullptr;
+	if (left.getType() == Value::Type::STRING_BUILDER)
+		builder = left.asStringBuilder()->append(rightData, rightSize);
+	//϶̵ֱַ
+	else if (leftSize + rightSize <= SHORT_STRING_LENGTH)
+	{
+		std::string str;
+		str.reserve(leftSize + rightSize);
+		str.append(leftData, leftSize);
+		str.append(rightData, rightSize);
+		return Value(str);
+	}
+	else
+		builder = StringBuilder::create(leftData, leftSize, rightData, rightSize);
+
+	Value value = Value(builder);
+	builder->release();
+	return value;
+}
+
+Value EvalVisitor::computeNumber(ASTree* t, int64_t left, const std::string& op, int64_t right)
+{
+	int64_t ret = 0;
+	//ʱתΪ
 	if ("+" == op)
-		return left + right;
+	{
+		if (!addOverflow(left, right, &ret))
+			return Value(ret);
+	}
 	else if ("-" == op)
-		return left - right;
+	{
+		if (!subOverflow(left, right, &ret))
+			return Value(ret);
+	}
 	else if ("*" == op)
-		return left * right;
+	{
+		if (!mulOverflow(left, right, &ret))
+			return Value(ret);
+	}
+	else if ("/" == op || "%" == op)
+	{
+		if (right == 0)
+			throw StoneException("divide by zero", t);
+		//INT64_MIN / -1 
+		if (right == -1)
+			return "/" == op ? this->computeBigInt(t, Value(left), op, Value(right)) : Value(0);
+		return Value("/" == op ? left / right : left % right);
+	}
+	else if ("==" == op)
+		return Value(left == right ? 1 : 0);
+	else if (">" == op)
+		return Value(left > right ? 1 : 0);
+	else if ("<" == op)
+		return Value(left < right ? 1 : 0);
+	else
+		throw StoneException("bad operator", t);
+	return this->computeBigInt(t, Value(left), op, Value(right));
+}
+
+Value EvalVisitor::computeBigInt(ASTree* t, const Value& left, const std::string& op, const Value& right)
+{
+	if ("+" == op)
+		return BigInt::add(left, right);
+	else if ("-" == op)
+		return BigInt::subtract(left, right);
+	else if ("*" == op)
+		return BigInt::multiply(left, right);
+	else if ("/" == op || "%" == op)
+	{
+		if (right.getType() == Value::Type::INTEGER && right.asLong() == 0)
+			throw StoneException("divide by zero", t);
+		return "/" == op ? BigInt::divide(left, right) : BigInt::mod(left, right);
+	}
+	else if ("==" == op)
+		return Value(BigInt::compare(left, right) == 0 ? 1 : 0);
+	else if (">" == op)
+		return Value(BigInt::compare(left, right) > 0 ? 1 : 0);
+	else if ("<" == op)
+		return Value(BigInt::compare(left, right) < 0 ? 1 : 0);
+	else
+		throw StoneException("bad operator", t);
+}
+
+Value EvalVisitor::computeNumber(ASTree* t, double left, const std::string& op, double right)
+{
+	if ("+" == op)
+		return Value(left + right);
+	else if ("-" == op)
+		return Value(left - right);
+	else if ("*" == op)
+		return Value(left * right);
 	else if ("/" == op)
-		return left / right;
+		return Value(left / right);
 	else if ("%" == op)
-		return left % right;
+		return Value(std::fmod(left, right));
 	else if ("==" == op)
-		return left == right;
+		return Value(left == right ? 1 : 0);
 	else if (">" == op)
-		return left > right;
+		return Value(left > right ? 1 : 0);
 	else if ("<" == op)
-		return left < right;
+		return Value(left < right ? 1 : 0);
 	else
 		throw StoneException("bad operator", t);
 }
 
+void EvalVisitor::assign(Name* name, const Value& value, Environment* env)
+{
+	this->checkWritable(name, env);
+	Value* target = this->getLocal(name, env);
+	if (target == nullptr)
+		target = this->getUpvalue(name, env);
+
+	if (target != nullptr)
+		*target = value;
+	else
+		env->put(name->getName(), value);
+}
 //---------------------------PrimaryExpr---------------------
-void EvalVisitor::evalSubExpr(PrimaryExpr* t, Environment* env, int nest)
+void EvalVisitor::evalSubExpr(PrimaryExpr* t, Environment* env, int nest, ValueVector* path)
 {
 	// foo(2)(3) δҵ
 	if (t->getNumChildren() - nest > 1)
 	{
-		this->evalSubExpr(t, env, nest + 1);
-		//ȡʵ
 		auto postfix = t->getChild(t->getNumChildren() - nest - 1);
+		ArrayRef* ref = dynamic_cast<ArrayRef*>(postfix);
+		if (ref != nullptr)
+		{
+			this->readElement(t, ref, env, nest, path);
+			return;
+		}
+		SliceRef* slice = dynamic_cast<SliceRef*>(postfix);
+		if (slice != nullptr)
+		{
+			this->sliceArray(t, slice, env, nest);
+			return;
+		}
+		this->evalSubExpr(t, env, nest + 1);
 		//Arguments,ú ĺѾthis->result֮
 		postfix->accept(this, env);
 	}
@@ -414,4 +928,393 @@ void EvalVisitor::evalSubExpr(PrimaryExpr* t, Environment* env, int nest)
 		name->accept(this, env);
 	}
 }
-NS_STONE_END
+
+Value* EvalVisitor::relocate(PrimaryExpr* t, Environment* env, const ValueVector& path, Value& temp, bool& copied)
+{
+	//鲻ʱֵʱǰĲֻб±꣬²Ҳٲ
+	t->getChild(0)->accept(this, env);
+	Value* array = this->result;
+	for (unsigned int i = 0; i < path.size() && array != nullptr; i++)
+	{
+		const Value& container = *array;
+		array = this->getElement(static_cast<ArrayRef*>(t->getChild(i + 1)), container, path[i], false);
+		//־ûͼԪزܱãreadElementһƳ
+		if (array != nullptr && (container.getType() == Value::Type::PERSISTENT_VECTOR || container.getType() == Value::Type::ARRAY_VIEW))
+		{
+			Value copy = *array;
+			temp = std::move(copy);
+			array = &temp;
+			copied = true;
+		}
+	}
+	return array;
+}
+//---------------------------ArrayRef---------------------
+Value* EvalVisitor::getElement(ArrayRef* t, const Value& array, const Value& index, bool create)
+{
+	//mapļΪַתΪַ
+	if (array.getType() == Value::Type::MAP)
+	{
+		if (!index.isString() && index.getType() != Value::Type::INTEGER)
+			throw StoneException("bad map key", t);
+
+		auto& map = array.asValueMap();
+		if (create)
+			return &map[index.asString()];
+		return map.find(index.asString());
+	}
+	//־ûֻܶȡ޸ʱµİ汾
+	if (array.getType() == Value::Type::PERSISTENT_VECTOR && !create)
+	{
+		auto vector = array.asPersistentVector();
+		if (index.getType() != Value::Type::INTEGER)
+			throw StoneException("bad array access", t);
+		if (index.asLong() < 0 || index.asLong() >= (int64_t)vector->size())
+			throw StoneException("array index out of range", t);
+		return const_cast<Value*>(&vector->at(index.asInt()));
+	}
+	//ͼֻʱֱӷʹĴ洢޸ʱasValueVector
+	if (array.getType() == Value::Type::ARRAY_VIEW && !create)
+	{
+		auto view = const_cast<Value&>(array).asArrayView();
+		if (index.getType() != Value::Type::INTEGER)
+			throw StoneException("bad array access", t);
+		if (index.asLong() < 0 || index.asLong() >= (int64_t)view->size())
+			throw StoneException("array index out of range", t);
+		return const_cast<Value*>(&view->at(index.asInt()));
+	}
+	//Ŀǰ֧
+	Value::Type type = array.getType();
+	if ((type != Value::Type::VECTOR && type != Value::Type::ARRAY_VIEW) || index.getType() != Value::Type::INTEGER)
+		throw StoneException("bad array access", t);
+
+	auto& list = array.asValueVector();
+	int64_t i = index.asLong();
+
+	if (i < 0 || i >= (int64_t)list.size())
+		throw StoneException("array index out of range", t);
+	return &list[i];
+}
+int EvalVisitor::evalSliceBound(SliceRef* t, ASTree* bound, Environment* env)
+{
+	bound->accept(this, env);
+
+	if (this->result->getType() != Value::Type::INTEGER || this->result->asLong() < 0 || this->result->asLong() > INT_MAX)
+		throw StoneException("bad slice", t);
+	return this->result->asInt();
+}
+//---------------------------ClosureStmnt---------------------
+Environment* EvalVisitor::makeClosureEnv(Upvalues* upvalues, Environment* env)
+{
+	//ȫֻеıҪ
+	Environment* global = env;
+	while (global->getOuter() != nullptr)
+		global = global->getOuter();
+
+	ClosureEnv* closureEnv = nullptr;
+	//ǷҪö廷
+	bool keepEnv = false;
+
+	for (unsigned int i = 0; i < upvalues->getSize(); i++)
+	{
+		auto& name = upvalues->getName(i);
+		Environment* where = env->where(name);
+		//δıǺڵľֲ֮ڶ廷
+		if (where == nullptr)
+		{
+			if (!upvalues->isLocal(i))
+				keepEnv = true;
+			continue;
+		}
+		else if (where == global)
+			continue;
+
+		if (closureEnv == nullptr)
+			closureEnv = new ClosureEnv(upvalues);
+		//ᱻ޸ĵıҪ붨廷ֱӸ
+		if (upvalues->isMutated(i))
+		{
+			closureEnv->setCell(i, where->getCell(name));
+		}
+		else
+		{
+			Cell* cell = new Cell(*where->get(name));
+			closureEnv->setCell(i, cell);
+			cell->release();
+		}
+	}
+	Environment* outer = keepEnv ? env : global;
+	//ûвκα
+	if (closureEnv == nullptr)
+	{
+		outer->retain();
+		return outer;
+	}
+	closureEnv->setOuter(outer);
+	return closureEnv;
+}
+
+Value* EvalVisitor::getUpvalue(Name* t, Environment* env)
+{
+	int index = t->getUpvalueIndex();
+	//ںʱĻУ㼴Ϊհ
+	if (index < 0 || env->getOuter() == nullptr)
+		return nullptr;
+	return env->getOuter()->getUpvalue(index);
+}
+void EvalVisitor::checkWritable(ASTree* target, Environment* env)
+{
+	if (!_concurrent)
+		return;
+	//Ժý޸ĲӰ
+	PrimaryExpr* primary = dynamic_cast<PrimaryExpr*>(target);
+	if (primary != nullptr)
+	{
+		for (int i = 1; i < primary->getNumChildren(); i++)
+		{
+			if (dynamic_cast<Arguments*>(primary->getChild(i)) != nullptr)
+				return;
+		}
+		target = primary->getChild(0);
+	}
+	Name* name = dynamic_cast<Name*>(target);
+	if (name == nullptr || this->getLocal(name, env) != nullptr)
+		return;
+	//ı㻷еıɸ̹߳
+	Environment* where = env->where(name->getName());
+	if (this->getUpvalue(name, env) != nullptr || (where != nullptr && where != env))
+		throw StoneException("cannot modify shared variable in parallel task: " + name->getName(), target);
+}
+//---------------------------Arguments---------------------
+void EvalVisitor::callWithFrame(Arguments* t, Function* function, FrameLayout* layout, Environment* env)
+{
+	//ڼ䱣֤ͷ
+	function->retain();
+	StackEnv* frame = this->pushFrame(layout, function->getEnvironment());
+
+	try
+	{
+		//βλջ֡ǰ
+		for (int i = 0; i < t->getNumChildren(); i++)
+		{
+			t->getChild(i)->accept(this, env);
+			frame->bind(i, *this->result);
+		}
+		this->checkYield();
+		function->execute(this, frame);
+		//ֵջ֡еıԪأջ֡ǰȸ
+		if (!this->isOwned())
+			this->setResult(*this->result);
+	}
+	catch (...)
+	{
+		this->popFrame();
+		function->release();
+		throw;
+	}
+	this->popFrame();
+	function->release();
+}
+
+void EvalVisitor::yield()
+{
+	_ticks = 0;
+	//񲻳н
+	if (_concurrent)
+		return;
+	TaskGroup* group = TaskGroup::getCurrent();
+	if (group != nullptr)
+		group->yield();
+}
+
+void EvalVisitor::callWithEnv(Arguments* t, Function* function, Environment* env, bool cached)
+{
+	//ֻresultУʱᱻ
+	function->retain();
+	//һµĻ
+	Environment* newEnv = function->makeEnv();
+
+	try
+	{
+		//ͶӦֵ
+		for (int i = 0; i < t->getNumChildren(); i++)
+		{
+			auto args = t->getChild(i);
+			//ȼ
+			args->accept(this, env);
+			//ӱ
+			if (cached)
+				newEnv->putNew(t->getCachedParamName(i), *this->result);
+			else
+				newEnv->putNew(function->getParamName(i), *this->result);
+		}
+		this->checkYield();
+		//ִк
+		function->execute(this, newEnv);
+		//ֵǵûеıͷŻǰȸ
+		if (!this->isOwned())
+			this->setResult(*this->result);
+	}
+	catch (...)
+	{
+		newEnv->release();
+		function->release();
+		throw;
+	}
+	//ͷŻ
+	newEnv->release();
+	function->release();
+}
+
+void EvalVisitor::callNative(Arguments* t, NativeFunction* function, Environment* env)
+{
+	unsigned int size = t->getNumChildren();
+	Value inlineArgs[MAX_INLINE_ARGS];
+	std::vector<Value> heapArgs;
+	Value* args = inlineArgs;
+
+	if (size > MAX_INLINE_ARGS)
+	{
+		heapArgs.resize(size);
+		args = heapArgs.data();
+	}
+	//׸ôʱ㣬ʱַʧЧ
+	NativeFunction::ArgMode mode = function->getArgMode();
+	unsigned int first = mode != NativeFunction::ArgMode::VALUE ? 1 : 0;
+	Value* target = nullptr;
+	bool borrowed = false;
+	//ڼ䱣֤ͷ
+	function->retain();
+	try
+	{
+		//λ
+		for (unsigned int i = first; i < size; i++)
+		{
+			t->getChild(i)->accept(this, env);
+			//ʱֱֵƶ⸴
+			if (this->isOwned())
+				args[i] = std::move(*this->result);
+			else
+				args[i] = *this->result;
+		}
+		if (first > 0)
+		{
+			if (mode == NativeFunction::ArgMode::WRITE)
+				this->checkWritable(t->getChild(0), env);
+			t->getChild(0)->accept(this, env);
+			//ʱֱֵƶ
+			if (this->isOwned())
+				args[0] = std::move(*this->result);
+			//ֻʱñֵ޸ģҲԴ빲ı
+			else if (mode == NativeFunction::ArgMode::READ)
+			{
+				args[0].borrow(*this->result);
+				borrowed = true;
+			}
+			//ѱֵƶУýƻ
+			else
+			{
+				target = this->result;
+				args[0] = std::move(*this->result);
+			}
+		}
+		Value ret;
+		function->call(args, &ret);
+		if (target != nullptr)
+			*target = std::move(args[0]);
+		if (borrowed)
+			args[0].unborrow();
+		this->setResult(std::move(ret));
+	}
+	catch (...)
+	{
+		if (target != nullptr)
+			*target = std::move(args[0]);
+		if (borrowed)
+			args[0].unborrow();
+		function->release();
+		throw;
+	}
+	function->release();
+}
+
+Value* EvalVisitor::getLocal(Name* t, Environment* env)
+{
+	int index = t->getSlotIndex();
+
+	if (index < 0)
+		return nullptr;
+	return env->getLocal(index);
+}
+
+Value EvalVisitor::invoke(Function* function, const Value* args, unsigned int argc)
+{
+	if (argc != function->getParamSize())
+		throw StoneException("bad number of arguments");
+
+	Value ret;
+	NativeFunction* native = dynamic_cast<NativeFunction*>(function);
+	if (native != nullptr && native->isFast())
+	{
+		//غ޸Ĳ븱
+		std::vector<Value> copies(args, args + argc);
+		native->call(copies.data(), &ret);
+		return ret;
+	}
+	FrameLayout* layout = function->getFrameLayout();
+	StackEnv* frame = nullptr;
+	Environment* newEnv = nullptr;
+	//ڼ䱣֤ͷ
+	function->retain();
+	try
+	{
+		if (layout != nullptr)
+		{
+			frame = this->pushFrame(layout, function->getEnvironment());
+			for (unsigned int i = 0; i < argc; i++)
+				frame->bind(i, args[i]);
+			function->execute(this, frame);
+		}
+		else
+		{
+			newEnv = function->makeEnv();
+			for (unsigned int i = 0; i < argc; i++)
+				newEnv->putNew(function->getParamName(i), args[i]);
+			function->execute(this, newEnv);
+		}
+		//ֵõûеıͷǰ
+		ret = *this->result;
+	}
+	catch (...)
+	{
+		if (frame != nullptr)
+			this->popFrame();
+		if (newEnv != nullptr)
+			newEnv->release();
+		function->release();
+		throw;
+	}
+	if (frame != nullptr)
+		this->popFrame();
+	if (newEnv != nullptr)
+		newEnv->release();
+	function->release();
+	return ret;
+}
+
+StackEnv* EvalVisitor::pushFrame(FrameLayout* layout, Environment* outer)
+{
+	if (_frameDepth == _frames.size())
+		_frames.push_back(new StackEnv());
+
+	StackEnv* frame = _frames[_frameDepth++];
+	frame->reset(layout, outer);
+
+	return frame;
+}
+
+void EvalVisitor::popFrame()
+{
+	_frames[--_frameDepth]->clear();
+}
+NS_STONE_END
\ No newline at end of file
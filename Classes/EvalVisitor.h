@@ -2,12 +2,16 @@
 #define __Stone_EvalVisitor_H__
 
 #include <string>
+#include <vector>
 
 #include "Visitor.h"
 #include "Value.h"
 
 NS_STONE_BEGIN
 
+//ÿִôѭüһǷҪó
+#define YIELD_INTERVAL 1024
+
 class Environment;
 class ASTree;
 class ASTList;
@@ -20,6 +24,8 @@ class BinaryExpr;
 class BlockStmnt;
 class IfStmnt;
 class WhileStmnt;
+class ForStmnt;
+class YieldStmnt;
 
 class PrimaryExpr;
 class Postfix;
@@ -27,6 +33,14 @@ class Arguments;
 class ParameterList;
 class DefStmnt;
 class ClosureStmnt;
+class Upvalues;
+class FrameLayout;
+class StackEnv;
+class ArrayRef;
+class MapLiteral;
+class SliceRef;
+class NativeFunction;
+class Generator;
 
 class EvalVisitor : public Visitor 
 {
@@ -55,6 +69,8 @@ public:
 	virtual void visit(IfStmnt* t, Environment* env);
 	//ѭ飬һֵresult
 	virtual void visit(WhileStmnt* t, Environment* env);
+	//һֵresult
+	virtual void visit(ForStmnt* t, Environment* env);
 
 	//---------------------------------
 	//ִ
@@ -67,30 +83,108 @@ public:
 	virtual void visit(DefStmnt* t, Environment* env);
 
 	virtual void visit(ClosureStmnt* t, Environment* env);
+	//ڵָresultΪֵ
+	virtual void visit(YieldStmnt* t, Environment* env);
 
 	//
 	virtual void visit(ArrayLiteral* t, Environment* env);
 	virtual void visit(ArrayRef* t, Environment* env);
+	//Ƭ
+	virtual void visit(SliceRef* t, Environment* env);
+	//map
+	virtual void visit(MapLiteral* t, Environment* env);
 public:
 	void setResult(int value);
 	void setResult(const std::string& value);
 	void setResult(const std::vector<Value>& value);
 	void setResult(Function* value);
 	void setResult(const Value& value);
+	void setResult(Value&& value);
+	//λõֵ
 	void setResult(Value* value);
+	//resultǷ񱣴ڼĴУΪõı
+	bool isOwned() const { return result == &_register; }
+	//λôúغصűʹ
+	Value invoke(Function* function, const Value* args, unsigned int argc);
+	//ִ̹߳﷨ͲĻ
+	//ʱµõĻ棬Ҳ޸Ĺı
+	void setConcurrent(bool concurrent) { _concurrent = concurrent; }
+	bool isConcurrent() const { return _concurrent; }
+	//ִyieldʱ
+	void setGenerator(Generator* generator) { _generator = generator; }
+	Generator* getGenerator() const { return _generator; }
 private:
 	//------BinaryExpr----
 	Value computeOp(ASTree* t, const Value& left, const std::string& op, const Value& right);
-	//TODO: ʱΪ
-	int computeNumber(ASTree* t, int left, const std::string& op, int right);
+	//߱Ԫ㣬Ϊ1ͱ㲥
+	Value computeArray(ASTree* t, const Value& left, const std::string& op, const Value& right);
+	//ַϳַʹStringBuilderظ
+	Value concat(const Value& left, const Value& right);
+	//
+	Value computeNumber(ASTree* t, int64_t left, const std::string& op, int64_t right);
+	//㣬ʱҲת
+	Value computeBigInt(ASTree* t, const Value& left, const std::string& op, const Value& right);
+	//㣬븡ʱΪdouble
+	Value computeNumber(ASTree* t, double left, const std::string& op, double right);
+
+	//ֵβջ֡հͻ
+	void assign(Name* name, const Value& value, Environment* env);
 
 	//------PrimaryExpr-----
-	void evalSubExpr(PrimaryExpr* t, Environment* env, int nest);
+	//ȥnest׺Ĳ֣pathΪnullptrʱμ¼е±
+	void evalSubExpr(PrimaryExpr* t, Environment* env, int nest, ValueVector* path = nullptr);
+	//¼±ӱ²飬洢ԪʱƵtempвcopiedΪtrue
+	//mapеļѱɾʱnullptr
+	Value* relocate(PrimaryExpr* t, Environment* env, const ValueVector& path, Value& temp, bool& copied);
+
+	//------ArrayRef-----
+	//ȡԪػmapֵĵַͻ׳쳣
+	//mapвڸüʱcreateΪtrueֵ򷵻nullptr
+	Value* getElement(ArrayRef* t, const Value& array, const Value& index, bool create);
+	//ȼټȡеԪ
+	void readElement(PrimaryExpr* t, ArrayRef* ref, Environment* env, int nest, ValueVector* path);
+
+	//------SliceRef-----
+	//ƬһˣΪǸ
+	int evalSliceBound(SliceRef* t, ASTree* bound, Environment* env);
+	//ȼټˣƬ
+	void sliceArray(PrimaryExpr* t, SliceRef* ref, Environment* env, int nest);
+
+	//------ClosureStmnt-----
+	//Ӷ廷вɱɺõĻ(retain)
+	Environment* makeClosureEnv(Upvalues* upvalues, Environment* env);
+	//ȡNameڵӦıհδ򷵻nullptr
+	Value* getUpvalue(Name* t, Environment* env);
+	//ֻ޸ıεõľֲ׳쳣
+	void checkWritable(ASTree* target, Environment* env);
+
+	//------Arguments-----
+	//ʹջ֡õûݵĺ
+	void callWithFrame(Arguments* t, Function* function, FrameLayout* layout, Environment* env);
+	//ٵñغУ
+	void callNative(Arguments* t, NativeFunction* function, Environment* env);
+	//µĻְ󶨲cachedΪfalseʱӺȡ
+	void callWithEnv(Arguments* t, Function* function, Environment* env, bool cached);
+	//ȡNameڵջ֡жӦıջ֡򷵻nullptr
+	Value* getLocal(Name* t, Environment* env);
+	StackEnv* pushFrame(FrameLayout* layout, Environment* outer);
+	void popFrame();
+	//ȴʱóresultʱñ
+	void checkYield() { if (++_ticks >= YIELD_INTERVAL) this->yield(); }
+	void yield();
 
 public:
 	Value* result;
 private:
-	bool _allocated;
+	//ļĴÿμ㶼ڴ
+	Value _register;
+	//ȸõջ֡
+	std::vector<StackEnv*> _frames;
+	unsigned int _frameDepth;
+	bool _concurrent;
+	Generator* _generator;
+	//һμóѭ͵ô
+	unsigned int _ticks;
 };
 NS_STONE_END
 #endif // ! __Stone_EvalVisitor_H__
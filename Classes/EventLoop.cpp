@@ -0,0 +1,434 @@
+#ifdef __linux__
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#endif
+#include <vector>
+
+#include "EventLoop.h"
+#include "EvalVisitor.h"
+#include "Function.h"
+#include "TaskGroup.h"
+#include "StoneException.h"
+
+NS_STONE_BEGIN
+
+#ifdef __linux__
+EventLoop::EventLoop()
+	:_epoll(-1)
+	,_wakeup(-1)
+	,_polling(false)
+{
+	//Զ˹رպд뷵EPIPEǽ
+	signal(SIGPIPE, SIG_IGN);
+
+	_epoll = epoll_create1(EPOLL_CLOEXEC);
+	_wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (_epoll < 0 || _wakeup < 0)
+		throw StoneException("failed to create event loop");
+
+	epoll_event event;
+	event.events = EPOLLIN;
+	event.data.fd = _wakeup;
+	epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeup, &event);
+}
+
+EventLoop::~EventLoop()
+{
+	while (!_watches.empty())
+		this->remove(_watches.begin()->second);
+	for (int fd : _owned)
+		::close(fd);
+	::close(_wakeup);
+	::close(_epoll);
+}
+
+int EventLoop::open(const std::string& path, const std::string& mode)
+{
+	int flags = 0;
+	if (mode == "r")
+		flags = O_RDONLY;
+	else if (mode == "w")
+		flags = O_WRONLY | O_CREAT | O_TRUNC;
+	else if (mode == "a")
+		flags = O_WRONLY | O_CREAT | O_APPEND;
+	else
+		throw StoneException("bad open mode: " + mode);
+
+	int fd = ::open(path.c_str(), flags | O_NONBLOCK | O_CLOEXEC, 0644);
+	if (fd < 0)
+		throw StoneException("cannot open file: " + path);
+	return this->own(fd);
+}
+
+void EventLoop::pipe(int fds[2])
+{
+	if (pipe2(fds, O_NONBLOCK | O_CLOEXEC) < 0)
+		throw StoneException("failed to create pipe");
+	this->own(fds[0]);
+	this->own(fds[1]);
+}
+
+//unix socketĵַ·ʱ׳쳣
+static sockaddr_un makeAddress(const std::string& path)
+{
+	sockaddr_un address = {};
+	if (path.size() >= sizeof(address.sun_path))
+		throw StoneException("socket path too long: " + path);
+	address.sun_family = AF_UNIX;
+	path.copy(address.sun_path, path.size());
+	return address;
+}
+
+int EventLoop::connect(const std::string& path)
+{
+	sockaddr_un address = makeAddress(path);
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		throw StoneException("failed to create socket");
+	if (::connect(fd, (sockaddr*)&address, sizeof(address)) < 0)
+	{
+		::close(fd);
+		throw StoneException("cannot connect: " + path);
+	}
+	return this->own(fd);
+}
+
+int EventLoop::listen(const std::string& path, Function* callback)
+{
+	sockaddr_un address = makeAddress(path);
+	//ɾϴsocketļ͵ļᱻɾ
+	struct stat info;
+	if (stat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode))
+		unlink(path.c_str());
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		throw StoneException("failed to create socket");
+	if (bind(fd, (sockaddr*)&address, sizeof(address)) < 0 || ::listen(fd, SOMAXCONN) < 0)
+	{
+		::close(fd);
+		throw StoneException("cannot listen: " + path);
+	}
+	this->own(fd);
+
+	Watch* watch = this->getWatch(fd);
+	watch->listening = true;
+	callback->retain();
+	watch->onRead = callback;
+	this->update(watch);
+	return fd;
+}
+
+int EventLoop::addTimer(unsigned int ms, bool repeat, Function* callback)
+{
+	int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (fd < 0)
+		throw StoneException("failed to create timer");
+	this->own(fd);
+
+	itimerspec spec = {};
+	spec.it_value.tv_sec = ms / 1000;
+	spec.it_value.tv_nsec = (ms % 1000) * 1000000L;
+	//ȫΪ0ֹͣʱ
+	if (ms == 0)
+		spec.it_value.tv_nsec = 1;
+	if (repeat)
+		spec.it_interval = spec.it_value;
+	timerfd_settime(fd, 0, &spec, nullptr);
+
+	Watch* watch = this->getWatch(fd);
+	watch->timer = true;
+	watch->repeat = repeat;
+	callback->retain();
+	watch->onRead = callback;
+	this->update(watch);
+	return fd;
+}
+
+void EventLoop::read(int fd, Function* callback)
+{
+	Watch* watch = this->getWatch(fd);
+	if (watch->timer || watch->listening)
+		throw StoneException("cannot read from timer or listening socket");
+	//滻֮ǰĻص
+	callback->retain();
+	if (watch->onRead != nullptr)
+		watch->onRead->release();
+	watch->onRead = callback;
+	this->update(watch);
+}
+
+void EventLoop::write(int fd, const std::string& data, Function* callback)
+{
+	Watch* watch = this->getWatch(fd);
+	if (watch->timer || watch->listening)
+		throw StoneException("cannot write to timer or listening socket");
+	if (callback != nullptr)
+		callback->retain();
+	watch->output.push_back({ data, 0, callback });
+	this->update(watch);
+}
+
+void EventLoop::close(int fd)
+{
+	auto it = _watches.find(fd);
+	if (it != _watches.end())
+		this->remove(it->second);
+	//¼ѭ(׼)ֻȡص
+	if (_owned.erase(fd) > 0)
+		::close(fd);
+}
+
+void EventLoop::runOnce(EvalVisitor* visitor, TaskGroup* group)
+{
+	//ͨļǾʱȴ
+	std::vector<std::pair<int, unsigned int>> ready;
+	for (auto& it : _watches)
+	{
+		if (it.second->file)
+			ready.push_back(std::make_pair(it.first, (unsigned int)(EPOLLIN | EPOLLOUT)));
+	}
+	epoll_event events[EVENT_MAX_EVENTS];
+	//ȴڼ
+	_polling = true;
+	group->release();
+	int n = epoll_wait(_epoll, events, EVENT_MAX_EVENTS, ready.empty() ? -1 : 0);
+	int error = errno;
+	group->acquire();
+	_polling = false;
+
+	if (n < 0 && error != EINTR)
+		throw StoneException("epoll_wait failed");
+	for (int i = 0; i < n; i++)
+	{
+		if (events[i].data.fd == _wakeup)
+		{
+			uint64_t count = 0;
+			::read(_wakeup, &count, sizeof(count));
+		}
+		else
+			ready.push_back(std::make_pair((int)events[i].data.fd, (unsigned int)events[i].events));
+	}
+	for (auto& it : ready)
+		this->dispatch(it.first, it.second, visitor);
+}
+
+EventLoop::Watch* EventLoop::getWatch(int fd)
+{
+	if (fd < 0)
+		throw StoneException("bad fd");
+	auto it = _watches.find(fd);
+	if (it != _watches.end())
+		return it->second;
+
+	Watch* watch = new Watch();
+	watch->fd = fd;
+	watch->file = false;
+	watch->timer = false;
+	watch->repeat = false;
+	watch->listening = false;
+	watch->onRead = nullptr;
+	watch->events = 0;
+	_watches[fd] = watch;
+	return watch;
+}
+
+void EventLoop::update(Watch* watch)
+{
+	unsigned int events = 0;
+	if (watch->onRead != nullptr)
+		events |= EPOLLIN;
+	if (!watch->output.empty())
+		events |= EPOLLOUT;
+	//ûлص¼ѭȴ
+	if (events == 0)
+	{
+		this->remove(watch);
+		return;
+	}
+	if (!watch->file && events != watch->events)
+	{
+		epoll_event event;
+		event.events = events;
+		event.data.fd = watch->fd;
+		int op = watch->events == 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+
+		if (epoll_ctl(_epoll, op, watch->fd, &event) < 0)
+		{
+			//ͨļ֧epollΪǾ
+			if (errno != EPERM)
+			{
+				this->remove(watch);
+				throw StoneException("bad fd");
+			}
+			watch->file = true;
+		}
+	}
+	watch->events = events;
+	this->wakeup();
+}
+
+void EventLoop::remove(Watch* watch)
+{
+	if (!watch->file && watch->events != 0)
+		epoll_ctl(_epoll, EPOLL_CTL_DEL, watch->fd, nullptr);
+	if (watch->onRead != nullptr)
+		watch->onRead->release();
+	for (auto& pending : watch->output)
+	{
+		if (pending.callback != nullptr)
+			pending.callback->release();
+	}
+	_watches.erase(watch->fd);
+	delete watch;
+	this->wakeup();
+}
+
+void EventLoop::dispatch(int fd, unsigned int events, EvalVisitor* visitor)
+{
+	auto it = _watches.find(fd);
+	//֮ǰĻصѾر
+	if (it == _watches.end())
+		return;
+	Watch* watch = it->second;
+
+	if (watch->timer)
+	{
+		uint64_t count = 0;
+		if (::read(fd, &count, sizeof(count)) != sizeof(count))
+			return;
+		//صڼ䱣֤ͷ
+		Function* callback = watch->onRead;
+		callback->retain();
+		callback->autorelease();
+		if (!watch->repeat)
+			this->close(fd);
+		visitor->invoke(callback, nullptr, 0);
+		return;
+	}
+	if (watch->listening)
+	{
+		int client = accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (client < 0)
+			return;
+		this->own(client);
+		Function* callback = watch->onRead;
+		callback->retain();
+		callback->autorelease();
+		Value arg = Value(client);
+		visitor->invoke(callback, &arg, 1);
+		return;
+	}
+	if ((events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && watch->onRead != nullptr)
+	{
+		this->handleRead(watch, visitor);
+		//صпܹر˸
+		it = _watches.find(fd);
+		if (it == _watches.end())
+			return;
+		watch = it->second;
+	}
+	if ((events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) && !watch->output.empty())
+		this->handleWrite(watch, visitor);
+}
+
+void EventLoop::handleRead(Watch* watch, EvalVisitor* visitor)
+{
+	std::string data(EVENT_READ_CHUNK, '\0');
+	ssize_t n = ::read(watch->fd, &data[0], data.size());
+	if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+		return;
+
+	Function* callback = watch->onRead;
+	callback->retain();
+	callback->autorelease();
+	//ڶǷݱ"0"֮ļֵ
+	Value args[2];
+	if (n > 0)
+	{
+		data.resize(n);
+		args[0] = Value(std::move(data));
+		args[1] = 0;
+	}
+	else
+	{
+		//β֪߳ͨټ
+		args[0] = "";
+		args[1] = 1;
+		watch->onRead = nullptr;
+		callback->release();
+		this->update(watch);
+	}
+	visitor->invoke(callback, args, 2);
+}
+
+void EventLoop::handleWrite(Watch* watch, EvalVisitor* visitor)
+{
+	Pending& pending = watch->output.front();
+	ssize_t n = ::write(watch->fd, pending.data.data() + pending.offset, pending.data.size() - pending.offset);
+	if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+		return;
+
+	int result = -1;
+	if (n >= 0)
+	{
+		pending.offset += n;
+		//ûдĲֵһοд
+		if (pending.offset < pending.data.size())
+			return;
+		result = (int)pending.data.size();
+	}
+	//תͷų
+	Function* callback = pending.callback;
+	if (callback != nullptr)
+		callback->autorelease();
+	watch->output.pop_front();
+	this->update(watch);
+
+	if (callback != nullptr)
+	{
+		Value arg = Value(result);
+		visitor->invoke(callback, &arg, 1);
+	}
+}
+
+int EventLoop::own(int fd)
+{
+	_owned.insert(fd);
+	return fd;
+}
+
+void EventLoop::wakeup()
+{
+	if (!_polling)
+		return;
+	uint64_t count = 1;
+	::write(_wakeup, &count, sizeof(count));
+}
+#else
+//ûepollƽֻ̨ӿڣI/Oʱ׳쳣
+static void unsupported()
+{
+	throw StoneException("async I/O is only supported on Linux");
+}
+
+EventLoop::EventLoop() :_epoll(-1), _wakeup(-1), _polling(false) {}
+EventLoop::~EventLoop() {}
+int EventLoop::open(const std::string& path, const std::string& mode) { unsupported(); return -1; }
+void EventLoop::pipe(int fds[2]) { unsupported(); }
+int EventLoop::connect(const std::string& path) { unsupported(); return -1; }
+int EventLoop::listen(const std::string& path, Function* callback) { unsupported(); return -1; }
+int EventLoop::addTimer(unsigned int ms, bool repeat, Function* callback) { unsupported(); return -1; }
+void EventLoop::read(int fd, Function* callback) { unsupported(); }
+void EventLoop::write(int fd, const std::string& data, Function* callback) { unsupported(); }
+void EventLoop::close(int fd) { unsupported(); }
+void EventLoop::runOnce(EvalVisitor* visitor, TaskGroup* group) {}
+#endif
+NS_STONE_END
\ No newline at end of file
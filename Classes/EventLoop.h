@@ -0,0 +1,106 @@
+#ifndef __Stone_EventLoop_H__
+#define __Stone_EventLoop_H__
+
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class Function;
+class EvalVisitor;
+class TaskGroup;
+
+//ÿοɶʱȡֽ
+#define EVENT_READ_CHUNK (64 * 1024)
+//ÿepoll_waitȡ¼
+#define EVENT_MAX_EVENTS 64
+
+/*
+	epoll첽I/Oÿһ֧ļܵunix socketͶʱ
+	дɺ¼ѭнű߳еעĺ
+	ȴ¼ʱͷŽԼУҲעµI/O
+	runOnceҪн
+	ͨļܼepollΪ
+	֧Linuxƽ̨ϴI/Oʱ׳쳣
+*/
+class EventLoop
+{
+public:
+	EventLoop();
+	virtual ~EventLoop();
+
+	//ԷʽļmodeΪrwaļ
+	int open(const std::string& path, const std::string& mode);
+	//ܵfds[0]Ϊˣfds[1]Ϊд
+	void pipe(int fds[2]);
+	//unix socket
+	int connect(const std::string& path);
+	//unix socketÿӵcallbackѴڵsocketļᱻ滻
+	int listen(const std::string& path, Function* callback);
+	//ʱʱcallbackrepeatΪtrueʱԴ
+	int addTimer(unsigned int ms, bool repeat, Function* callback);
+
+	//ɶʱcallback(data, 0)ʱһcallback("", 1)ټ
+	void read(int fd, Function* callback);
+	//дݣȫдֽcallbackʱΪ-1callbackΪnullptr
+	//ͬһд밴˳
+	void write(int fd, const std::string& data, Function* callback);
+	//ȡϵлصرգδдݱ
+	void close(int fd);
+
+	//ûеȴеI/OͶʱ
+	bool isEmpty() const { return _watches.empty(); }
+	//ȴһ¼öӦĻصʱҪн
+	void runOnce(EvalVisitor* visitor, TaskGroup* group);
+private:
+	//ȴд
+	struct Pending
+	{
+		std::string data;
+		size_t offset;
+		Function* callback;
+	};
+	//עĻص
+	struct Watch
+	{
+		int fd;
+		//ͨļepoll
+		bool file;
+		//ʱ߼еsocketɶʱȡ
+		bool timer;
+		bool repeat;
+		bool listening;
+		Function* onRead;
+		std::deque<Pending> output;
+		//ǰepollע¼
+		unsigned int events;
+	};
+	//ȡӦWatchû򴴽
+	Watch* getWatch(int fd);
+	//ص¼¼ûлصʱƳ
+	void update(Watch* watch);
+	//ƳͷŻصر
+	void remove(Watch* watch);
+	//һϵ¼صпܹرո
+	void dispatch(int fd, unsigned int events, EvalVisitor* visitor);
+	void handleRead(Watch* watch, EvalVisitor* visitor);
+	void handleWrite(Watch* watch, EvalVisitor* visitor);
+	//¼¼ѭʱر
+	int own(int fd);
+	//epoll_waitʱ߳޸˼Ҫ
+	void wakeup();
+private:
+	int _epoll;
+	//ڻepoll_waiteventfd
+	int _wakeup;
+	//Ƿڵȴ¼ֻڳнʱд
+	bool _polling;
+	std::unordered_map<int, Watch*> _watches;
+	std::unordered_set<int> _owned;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
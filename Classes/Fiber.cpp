@@ -0,0 +1,77 @@
+#include "Fiber.h"
+#include "Coroutine.h"
+#include "Function.h"
+#include "EvalVisitor.h"
+#include "StoneException.h"
+#include "STAutoreleasePool.h"
+
+NS_STONE_BEGIN
+
+thread_local Fiber* Fiber::_current = nullptr;
+
+Fiber::Fiber(Function* function, TaskGroup* group)
+	:_function(function)
+	,_group(group)
+	,_visitor(new EvalVisitor())
+	,_pool(new AutoreleasePool())
+	,_coroutine(nullptr)
+	,_state(State::READY)
+	,_cancelled(false)
+{
+	function->retain();
+	_coroutine = new Coroutine([this]() { this->run(); }, FIBER_STACK_SIZE);
+}
+
+Fiber::~Fiber()
+{
+	delete _coroutine;
+	_function->release();
+	delete _visitor;
+	_pool->clear();
+	delete _pool;
+}
+
+Fiber* Fiber::getCurrent()
+{
+	return _current;
+}
+
+void Fiber::resume()
+{
+	Fiber* previous = _current;
+	//ԶͷŵĶԼͷųأʱ
+	AutoreleasePool* pool = AutoreleasePool::setInstance(_pool);
+	_current = this;
+	_state = State::RUNNING;
+	_coroutine->resume();
+	_current = previous;
+	AutoreleasePool::setInstance(pool);
+}
+
+void Fiber::park()
+{
+	_state = State::PARKED;
+	_coroutine->suspend();
+}
+
+void Fiber::yield()
+{
+	_state = State::READY;
+	_coroutine->suspend();
+}
+
+void Fiber::run()
+{
+	try
+	{
+		_visitor->invoke(_function, nullptr, 0);
+	}
+	catch (std::exception& e)
+	{
+		//ȡ
+		if (!_cancelled)
+			_error = e.what();
+	}
+	_state = State::FINISHED;
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef __Stone_Fiber_H__
+#define __Stone_Fiber_H__
+
+#include <string>
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+//ÿջСֻʹõʱռڴ
+#define FIBER_STACK_SIZE (1024 * 1024)
+
+class Function;
+class EvalVisitor;
+class TaskGroup;
+class AutoreleasePool;
+class Coroutine;
+
+/*
+	spawnԼЭ
+	ÿԼִԼĵ֡ȹ
+	ڵһ߳лָֻڳʱ
+	TaskGroupʹü
+*/
+class Fiber
+{
+public:
+	enum class State
+	{
+		//Уȴ
+		READY,
+		RUNNING,
+		//ȴͨȱ
+		PARKED,
+		FINISHED
+	};
+public:
+	Fiber(Function* function, TaskGroup* group);
+	virtual ~Fiber();
+
+	//ڵǰ߳Уֱó󷵻
+	void resume();
+	//ǰе񣬲ʱnullptr
+	static Fiber* getCurrent();
+	//ֻеãлصresume߳
+	//ֱµ
+	void park();
+	//ֿУִ
+	void yield();
+
+	//ȡȴе񣬻ָɵȴĵط׳쳣
+	void cancel() { _cancelled = true; }
+	bool isCancelled() const { return _cancelled; }
+
+	State getState() const { return _state; }
+	TaskGroup* getGroup() const { return _group; }
+	//δ쳣ϢȡʱΪ
+	const std::string& getError() const { return _error; }
+private:
+	//Э̵ĺ
+	void run();
+private:
+	Function* _function;
+	TaskGroup* _group;
+	EvalVisitor* _visitor;
+	AutoreleasePool* _pool;
+	Coroutine* _coroutine;
+	State _state;
+	bool _cancelled;
+	std::string _error;
+
+	static thread_local Fiber* _current;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
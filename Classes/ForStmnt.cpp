@@ -0,0 +1,36 @@
+#include "ForStmnt.h"
+#include "Name.h"
+#include "Visitor.h"
+
+NS_STONE_BEGIN
+
+ForStmnt::ForStmnt(const std::vector<ASTree*>& list)
+	:ASTList(list)
+{
+}
+
+Name* ForStmnt::getName() const
+{
+	return static_cast<Name*>(getChild(0));
+}
+
+ASTree* ForStmnt::getSource() const
+{
+	return getChild(1);
+}
+
+ASTree* ForStmnt::getBody() const
+{
+	return getChild(2);
+}
+
+void ForStmnt::accept(Visitor* v, Environment* env)
+{
+	v->visit(this, env);
+}
+
+std::string ForStmnt::toString() const
+{
+	return "(for " + getName()->toString() + " " + getSource()->toString() + " " + getBody()->toString() + ")";
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef __Stone_ForStmnt_H__
+#define __Stone_ForStmnt_H__
+
+#include "ASTList.h"
+
+NS_STONE_BEGIN
+
+class Visitor;
+class Environment;
+class Name;
+
+//for name in expr block ߰ȡֵ
+class ForStmnt : public ASTList
+{
+public:
+	ForStmnt(const std::vector<ASTree*>& list);
+
+	//ѭ
+	Name* getName() const;
+	ASTree* getSource() const;
+	ASTree* getBody() const;
+public:
+	virtual void accept(Visitor* v, Environment* env);
+	virtual std::string toString() const;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
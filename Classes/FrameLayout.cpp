@@ -0,0 +1,39 @@
+#include "FrameLayout.h"
+
+NS_STONE_BEGIN
+
+FrameLayout::FrameLayout()
+{
+}
+
+FrameLayout::~FrameLayout()
+{
+}
+
+int FrameLayout::add(const std::string& name)
+{
+	_names.push_back(name);
+
+	return _names.size() - 1;
+}
+
+int FrameLayout::indexOf(const std::string& name) const
+{
+	for (unsigned int i = 0; i < _names.size(); i++)
+	{
+		if (_names[i] == name)
+			return i;
+	}
+	return -1;
+}
+
+unsigned int FrameLayout::getSize() const
+{
+	return _names.size();
+}
+
+const std::string& FrameLayout::getName(unsigned int index) const
+{
+	return _names.at(index);
+}
+NS_STONE_END
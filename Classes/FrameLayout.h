@@ -0,0 +1,33 @@
+#ifndef __Stone_FrameLayout_H__
+#define __Stone_FrameLayout_H__
+
+#include <string>
+#include <vector>
+
+#include "STObject.h"
+
+NS_STONE_BEGIN
+
+/*
+	ջ֣֡ûбУβǰֲں
+	ֻеûݵĺջ֡
+*/
+class FrameLayout : public Object
+{
+public:
+	FrameLayout();
+	virtual ~FrameLayout();
+
+	//ӱ
+	int add(const std::string& name);
+	//ȡӦ򷵻-1
+	int indexOf(const std::string& name) const;
+	//ȡ
+	unsigned int getSize() const;
+	//ȡ
+	const std::string& getName(unsigned int index) const;
+private:
+	std::vector<std::string> _names;
+};
+NS_STONE_END
+#endif
@@ -0,0 +1,300 @@
+#include "FreeVarVisitor.h"
+#include "ASTree.h"
+#include "ASTList.h"
+#include "ASTLeaf.h"
+#include "Name.h"
+#include "NegativeExpr.h"
+#include "BinaryExpr.h"
+#include "IfStmnt.h"
+#include "WhileStmnt.h"
+#include "ForStmnt.h"
+#include "YieldStmnt.h"
+#include "PrimaryExpr.h"
+#include "Postfix.h"
+#include "Arguments.h"
+#include "ParameterList.h"
+#include "BlockStmnt.h"
+#include "DefStmnt.h"
+#include "ClosureStmnt.h"
+#include "ArrayLiteral.h"
+#include "ArrayRef.h"
+#include "MapLiteral.h"
+#include "SliceRef.h"
+#include "Upvalues.h"
+#include "FrameLayout.h"
+
+NS_STONE_BEGIN
+FreeVarVisitor::FreeVarVisitor()
+{
+}
+
+FreeVarVisitor::~FreeVarVisitor()
+{
+}
+
+void FreeVarVisitor::visit(ASTree* t, Environment* env)
+{
+}
+
+void FreeVarVisitor::visit(ASTList* t, Environment* env)
+{
+	this->visitChildren(t, env);
+}
+
+void FreeVarVisitor::visit(ASTLeaf* t, Environment* env)
+{
+}
+
+void FreeVarVisitor::visit(NumberLiteral* t, Environment* env)
+{
+}
+
+void FreeVarVisitor::visit(StringLiteral* t, Environment* env)
+{
+}
+
+void FreeVarVisitor::visit(Name* t, Environment* env)
+{
+	this->reference(t->getName(), t);
+}
+
+void FreeVarVisitor::visit(NegativeExpr* t, Environment* env)
+{
+	this->visitChildren(t, env);
+}
+
+void FreeVarVisitor::visit(BinaryExpr* t, Environment* env)
+{
+	if (t->getOperator() == "=")
+	{
+		//a = v  a[i] = v ޸ıa
+		Name* name = dynamic_cast<Name*>(t->getLeft());
+		PrimaryExpr* primary = dynamic_cast<PrimaryExpr*>(t->getLeft());
+
+		if (name == nullptr && primary != nullptr)
+			name = dynamic_cast<Name*>(primary->getChild(0));
+		if (name != nullptr)
+			this->assign(name->getName());
+	}
+	t->getLeft()->accept(this, env);
+	t->getRight()->accept(this, env);
+}
+
+void FreeVarVisitor::visit(BlockStmnt* t, Environment* env)
+{
+	this->visitChildren(t, env);
+}
+
+void FreeVarVisitor::visit(IfStmnt* t, Environment* env)
+{
+	this->visitChildren(t, env);
+	//else鲻ӽڵ
+	if (t->getElseBlock() != nullptr)
+		t->getElseBlock()->accept(this, env);
+}
+
+void FreeVarVisitor::visit(WhileStmnt* t, Environment* env)
+{
+	this->visitChildren(t, env);
+}
+
+void FreeVarVisitor::visit(ForStmnt* t, Environment* env)
+{
+	this->assign(t->getName()->getName());
+	this->visitChildren(t, env);
+}
+
+void FreeVarVisitor::visit(PrimaryExpr* t, Environment* env)
+{
+	this->visitChildren(t, env);
+}
+
+void FreeVarVisitor::visit(Postfix* t, Environment* env)
+{
+	this->visitChildren(t, env);
+}
+
+void FreeVarVisitor::visit(Arguments* t, Environment* env)
+{
+	//׸ܰôغ(push)ʱᱻ޸
+	Name* name = t->getNumChildren() > 0 ? dynamic_cast<Name*>(t->getChild(0)) : nullptr;
+	if (name != nullptr)
+		this->mutate(name->getName());
+	this->visitChildren(t, env);
+}
+
+void FreeVarVisitor::visit(DefStmnt* t, Environment* env)
+{
+	//ᱻӵ㻷
+	this->assign(t->getName());
+	//㺯ĵûᱻ
+	if (!_scopes.empty())
+		_scopes.back().escaping = true;
+
+	FrameLayout* layout = nullptr;
+	bool generator = false;
+	Upvalues* upvalues = this->analyze(t->getParameters(), t->getBody(), layout, generator);
+	t->setUpvalues(upvalues);
+	t->setFrameLayout(layout);
+	t->setGenerator(generator);
+	upvalues->release();
+	if (layout != nullptr)
+		layout->release();
+}
+
+void FreeVarVisitor::visit(ClosureStmnt* t, Environment* env)
+{
+	//㺯ĵûᱻ
+	if (!_scopes.empty())
+		_scopes.back().escaping = true;
+
+	FrameLayout* layout = nullptr;
+	bool generator = false;
+	Upvalues* upvalues = this->analyze(t->getParameters(), t->getBody(), layout, generator);
+	t->setUpvalues(upvalues);
+	t->setFrameLayout(layout);
+	t->setGenerator(generator);
+	upvalues->release();
+	if (layout != nullptr)
+		layout->release();
+}
+
+void FreeVarVisitor::visit(YieldStmnt* t, Environment* env)
+{
+	//ĵûУʹջ֡
+	if (!_scopes.empty())
+	{
+		_scopes.back().generator = true;
+		_scopes.back().escaping = true;
+	}
+	this->visitChildren(t, env);
+}
+
+void FreeVarVisitor::visit(ArrayLiteral* t, Environment* env)
+{
+	this->visitChildren(t, env);
+}
+
+void FreeVarVisitor::visit(ArrayRef* t, Environment* env)
+{
+	this->visitChildren(t, env);
+}
+
+void FreeVarVisitor::visit(SliceRef* t, Environment* env)
+{
+	this->visitChildren(t, env);
+}
+
+void FreeVarVisitor::visit(MapLiteral* t, Environment* env)
+{
+	this->visitChildren(t, env);
+}
+
+Upvalues* FreeVarVisitor::analyze(ParameterList* params, BlockStmnt* body, FrameLayout*& layout, bool& generator)
+{
+	Scope scope;
+	scope.escaping = false;
+	scope.generator = false;
+	scope.upvalues = new Upvalues();
+
+	for (int i = 0; i < params->getSize(); i++)
+		scope.params.insert(params->getName(i));
+
+	_scopes.push_back(scope);
+	body->accept(this, nullptr);
+
+	//
+	scope = _scopes.back();
+	_scopes.pop_back();
+	Upvalues* upvalues = scope.upvalues;
+	generator = scope.generator;
+
+	for (unsigned int i = 0; i < upvalues->getSize(); i++)
+		upvalues->setLocal(i, scope.assigned.find(upvalues->getName(i)) != scope.assigned.end());
+	_results.push_back(upvalues);
+
+	//ûݣβκ;ֲջ֡
+	layout = nullptr;
+	if (!scope.escaping)
+	{
+		layout = new FrameLayout();
+		for (int i = 0; i < params->getSize(); i++)
+			layout->add(params->getName(i));
+		for (unsigned int i = 0; i < upvalues->getSize(); i++)
+		{
+			if (upvalues->isLocal(i))
+				layout->add(upvalues->getName(i));
+		}
+		for (auto name : scope.names)
+			name->setSlotIndex(layout->indexOf(name->getName()));
+	}
+
+	//ڲɱͬ㺯ɱ
+	if (!_scopes.empty())
+	{
+		for (unsigned int i = 0; i < upvalues->getSize(); i++)
+			this->reference(upvalues->getName(i), nullptr);
+		//βεĸֵֻӰ챾
+		for (auto& name : scope.assigned)
+		{
+			if (scope.params.find(name) == scope.params.end())
+				_scopes.back().assigned.insert(name);
+		}
+	}
+	//㺯ɣʱȷǷᱻ޸
+	else
+	{
+		for (auto result : _results)
+		{
+			for (unsigned int i = 0; i < result->getSize(); i++)
+				result->setMutated(i, _assigned.find(result->getName(i)) != _assigned.end());
+		}
+		_results.clear();
+		_assigned.clear();
+	}
+	return upvalues;
+}
+
+void FreeVarVisitor::visitChildren(ASTree* t, Environment* env)
+{
+	for (auto it = t->begin(); it != t->end(); it++)
+	{
+		(*it)->accept(this, env);
+	}
+}
+
+void FreeVarVisitor::reference(const std::string& name, Name* t)
+{
+	//ں
+	if (_scopes.empty())
+		return;
+
+	Scope& scope = _scopes.back();
+	int index = -1;
+	//ββɱ
+	if (scope.params.find(name) == scope.params.end())
+	{
+		index = scope.upvalues->indexOf(name);
+		if (index < 0)
+			index = scope.upvalues->add(name);
+	}
+	if (t != nullptr)
+	{
+		t->setUpvalueIndex(index);
+		scope.names.push_back(t);
+	}
+}
+
+void FreeVarVisitor::mutate(const std::string& name)
+{
+	_assigned.insert(name);
+}
+
+void FreeVarVisitor::assign(const std::string& name)
+{
+	_assigned.insert(name);
+
+	if (!_scopes.empty())
+		_scopes.back().assigned.insert(name);
+}
+NS_STONE_END
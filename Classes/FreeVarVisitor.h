@@ -0,0 +1,91 @@
+#ifndef __Stone_FreeVarVisitor_H__
+#define __Stone_FreeVarVisitor_H__
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+#include "Visitor.h"
+
+NS_STONE_BEGIN
+
+class Upvalues;
+class FrameLayout;
+
+/*
+	ɱóÿdef/closureõɱ
+	ɱдӦNameڵС
+	ͬʱݷڲûdef/closureĺûᱻ
+	Ϊջ֡֡
+	ĺʼڲĺһ
+*/
+class FreeVarVisitor : public Visitor
+{
+public:
+	FreeVarVisitor();
+	virtual ~FreeVarVisitor();
+public:
+	virtual void visit(ASTree* t, Environment* env);
+	virtual void visit(ASTList* t, Environment* env);
+	virtual void visit(ASTLeaf* t, Environment* env);
+	virtual void visit(NumberLiteral* t, Environment* env);
+	virtual void visit(StringLiteral* t, Environment* env);
+	//¼
+	virtual void visit(Name* t, Environment* env);
+	virtual void visit(NegativeExpr* t, Environment* env);
+	//¼ֵı
+	virtual void visit(BinaryExpr* t, Environment* env);
+	virtual void visit(BlockStmnt* t, Environment* env);
+	virtual void visit(IfStmnt* t, Environment* env);
+	virtual void visit(WhileStmnt* t, Environment* env);
+	//¼ѭֵ
+	virtual void visit(ForStmnt* t, Environment* env);
+
+	virtual void visit(PrimaryExpr* t, Environment* env);
+	virtual void visit(Postfix* t, Environment* env);
+	virtual void visit(Arguments* t, Environment* env);
+	//壬ڽڵ
+	virtual void visit(DefStmnt* t, Environment* env);
+	virtual void visit(ClosureStmnt* t, Environment* env);
+	//ڵĺΪ
+	virtual void visit(YieldStmnt* t, Environment* env);
+
+	virtual void visit(ArrayLiteral* t, Environment* env);
+	virtual void visit(ArrayRef* t, Environment* env);
+	virtual void visit(SliceRef* t, Environment* env);
+	virtual void visit(MapLiteral* t, Environment* env);
+private:
+	//
+	struct Scope
+	{
+		//β
+		std::unordered_set<std::string> params;
+		//(ڲ)бֵı
+		std::unordered_set<std::string> assigned;
+		//ñĽڵ
+		std::vector<Name*> names;
+		//ڲǷ˺ûܱ
+		bool escaping;
+		//yieldû
+		bool generator;
+		Upvalues* upvalues;
+	};
+	//壬ɱûʱlayoutΪջ֡
+	//generatorΪǷyield
+	Upvalues* analyze(ParameterList* params, BlockStmnt* body, FrameLayout*& layout, bool& generator);
+	void visitChildren(ASTree* t, Environment* env);
+	//˱tΪnullptrʾڲɱ
+	void reference(const std::string& name, Name* t);
+	//ֵ
+	void assign(const std::string& name);
+	//ֵᱻ޸ģǸֵΪֲ
+	void mutate(const std::string& name);
+private:
+	std::vector<Scope> _scopes;
+	//㺯бֵı
+	std::unordered_set<std::string> _assigned;
+	//ѷɱȴ㺯Ƿ޸
+	std::vector<Upvalues*> _results;
+};
+NS_STONE_END
+#endif
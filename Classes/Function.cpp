@@ -3,8 +3,11 @@
 #include "NestedEnv.h"
 
 NS_STONE_BEGIN
+std::atomic<unsigned int> Function::_serialCounter(0);
+
 Function::Function(Environment* env)
 	:_env(env)
+	,_serial(++_serialCounter)
 {
 	//øû
 	_env->retain();
@@ -25,4 +28,9 @@ Environment* Function::makeEnv()
 	return new NestedEnv(_env);
 }
 
+FrameLayout* Function::getFrameLayout() const
+{
+	return nullptr;
+}
+
 NS_STONE_END
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define __Stone_Function_H__
 
 #include <string>
+#include <atomic>
 
 #include "StObject.h"
 
@@ -11,6 +12,7 @@ class ParameterList;
 class BlockStmnt;
 class Environment;
 class Visitor;
+class FrameLayout;
 
 class Function: public Object
 {
@@ -20,6 +22,8 @@ public:
 	Environment* getEnvironment() const;
 	//ڱ
 	Environment* makeEnv();
+	//ȡţÿΨһڵõж
+	unsigned int getSerial() const { return _serial; }
 public:
 	//ȡ
 	virtual unsigned int getParamSize() const = 0;
@@ -27,8 +31,14 @@ public:
 	virtual std::string getParamName(unsigned index) const = 0;
 	//ִк
 	virtual void execute(Visitor* v, Environment* env) = 0;
+	//ȡջ֣֡ΪnullptrʱҪµĻ
+	virtual FrameLayout* getFrameLayout() const;
 protected:
 	Environment* _env;
+private:
+	unsigned int _serial;
+	//Ҳᴴ
+	static std::atomic<unsigned int> _serialCounter;
 };
 NS_STONE_END
 #endif // !__Stone_Function_H__
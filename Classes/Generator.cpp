@@ -0,0 +1,94 @@
+#include "Generator.h"
+#include "Coroutine.h"
+#include "ScriptFunction.h"
+#include "BlockStmnt.h"
+#include "Environment.h"
+#include "EvalVisitor.h"
+#include "StoneException.h"
+#include "TaskPool.h"
+
+NS_STONE_BEGIN
+
+Generator::Generator(ScriptFunction* function, Environment* env, bool concurrent)
+	:_function(function)
+	,_env(env)
+	,_visitor(new EvalVisitor())
+	,_coroutine(nullptr)
+	,_state(State::CREATED)
+	,_closing(false)
+{
+	function->retain();
+	env->retain();
+	//дͬд빲Ļ
+	_visitor->setConcurrent(concurrent);
+	_visitor->setGenerator(this);
+}
+
+Generator::~Generator()
+{
+	//yieldú׳쳣˳ͷջõĶ
+	if (_state == State::SUSPENDED)
+	{
+		_closing = true;
+		_coroutine->resume();
+	}
+	delete _coroutine;
+	delete _visitor;
+	_env->release();
+	_function->release();
+}
+
+bool Generator::next(Value& value)
+{
+	//ֻһִУܴӶ߳ͬʱָ
+	if (TaskPool::isInTask())
+		throw StoneException("generators are not available in parallel tasks");
+	if (_state == State::FINISHED)
+		return false;
+	if (_state == State::RUNNING)
+		throw StoneException("generator is already running");
+	if (_coroutine == nullptr)
+		_coroutine = new Coroutine([this]() { this->run(); }, GENERATOR_STACK_SIZE);
+
+	//пͷһ
+	this->retain();
+	_state = State::RUNNING;
+	_coroutine->resume();
+
+	bool ret = _state == State::SUSPENDED;
+	if (ret)
+		value = std::move(_value);
+	std::string error;
+	error.swap(_error);
+	this->release();
+
+	if (!error.empty())
+		throw StoneException(error);
+	return ret;
+}
+
+void Generator::yield(const Value& value)
+{
+	_value = value;
+	_state = State::SUSPENDED;
+	_coroutine->suspend();
+	if (_closing)
+		throw StoneException("generator closed");
+	_state = State::RUNNING;
+}
+
+void Generator::run()
+{
+	try
+	{
+		_function->getBody()->accept(_visitor, _env);
+	}
+	catch (std::exception& e)
+	{
+		if (!_closing)
+			_error = e.what();
+	}
+	_value = Value::Null;
+	_state = State::FINISHED;
+}
+NS_STONE_END
\ No newline at end of file
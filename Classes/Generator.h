@@ -0,0 +1,62 @@
+#ifndef __Stone_Generator_H__
+#define __Stone_Generator_H__
+
+#include <string>
+
+#include "STObject.h"
+#include "Value.h"
+
+NS_STONE_BEGIN
+
+//ջСֻʹõʱռڴ
+#define GENERATOR_STACK_SIZE (1024 * 1024)
+
+class ScriptFunction;
+class Environment;
+class EvalVisitor;
+class Coroutine;
+
+/*
+	úyieldĺʱڵʱִ
+	ԼЭִ̺Уyieldʱ𣬵֡Эջ
+	ÿֻһֵʱҪз
+	δͱͷʱyield׳쳣ú˳
+*/
+class Generator : public Object
+{
+public:
+	//envΪѰ󶨲ĵûconcurrentΪִǷڲģʽ
+	Generator(ScriptFunction* function, Environment* env, bool concurrent);
+	virtual ~Generator();
+
+	//ִеһyieldȡֵʱfalse
+	//е쳣׳вܵ
+	bool next(Value& value);
+	bool isFinished() const { return _state == State::FINISHED; }
+	//еyieldãֱһnextvalueΪֵ
+	void yield(const Value& value);
+private:
+	enum class State
+	{
+		CREATED,
+		RUNNING,
+		SUSPENDED,
+		FINISHED
+	};
+	//Э̵ĺ
+	void run();
+private:
+	ScriptFunction* _function;
+	Environment* _env;
+	EvalVisitor* _visitor;
+	//һnextʱŴ
+	Coroutine* _coroutine;
+	State _state;
+	//һyieldֵ
+	Value _value;
+	//ͷʱҪ˳
+	bool _closing;
+	std::string _error;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
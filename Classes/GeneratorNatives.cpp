@@ -0,0 +1,40 @@
+#include "GeneratorNatives.h"
+#include "Environment.h"
+#include "StoneException.h"
+#include "Generator.h"
+
+NS_STONE_BEGIN
+
+static Generator* getGenerator(const Value& value)
+{
+	if (value.getType() != Value::Type::GENERATOR)
+		throw StoneException("bad generator");
+	return value.asGenerator();
+}
+
+//next(g) ִеһyieldزֵ󷵻ؿֵisnullж
+static void next(Value* args, unsigned int argc, Value* ret)
+{
+	Value value;
+	if (getGenerator(args[0])->next(value))
+		*ret = value;
+}
+
+//collect(g) ʣֵη
+static void collect(Value* args, unsigned int argc, Value* ret)
+{
+	Generator* generator = getGenerator(args[0]);
+	ValueVector values;
+	Value value;
+
+	while (generator->next(value))
+		values.push_back(value);
+	*ret = Value(values);
+}
+
+void registerGeneratorNatives(Environment* env)
+{
+	env->putNative("next", next, 1);
+	env->putNative("collect", collect, 1);
+}
+NS_STONE_END
\ No newline at end of file
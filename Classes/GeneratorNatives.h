@@ -0,0 +1,18 @@
+#ifndef __Stone_GeneratorNatives_H__
+#define __Stone_GeneratorNatives_H__
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class Environment;
+
+/*
+	ıغ next collect
+	next(g)ȡһֵ󷵻ؿֵcollect(g)ȡʣֵ
+	һʹ for x in g ҪЩ
+*/
+void registerGeneratorNatives(Environment* env);
+
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -0,0 +1,343 @@
+#include <cstring>
+#include <functional>
+
+#include "HashMap.h"
+#include "Value.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STONE_USE_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+//ÿλ
+#define GROUP_SIZE 16
+#define CTRL_EMPTY 0x80
+#define CTRL_DELETED 0xFE
+
+NS_STONE_BEGIN
+
+struct HashMap::Entry
+{
+	std::string key;
+	Value value;
+};
+
+//ȡڿλbĲλ
+static unsigned int matchByte(const unsigned char* group, unsigned char b)
+{
+#ifdef STONE_USE_SSE2
+	__m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(b))));
+#else
+	unsigned int mask = 0;
+	for (unsigned int i = 0; i < GROUP_SIZE; i++)
+	{
+		if (group[i] == b)
+			mask |= 1u << i;
+	}
+	return mask;
+#endif
+}
+
+//ȡڿղۻɾλ룬λΪ1Ŀλ
+static unsigned int matchFree(const unsigned char* group)
+{
+#ifdef STONE_USE_SSE2
+	return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group)));
+#else
+	unsigned int mask = 0;
+	for (unsigned int i = 0; i < GROUP_SIZE; i++)
+	{
+		if (group[i] & 0x80)
+			mask |= 1u << i;
+	}
+	return mask;
+#endif
+}
+
+//͵Ϊ1λmaskΪ0
+static unsigned int lowestBit(unsigned int mask)
+{
+#if defined(__GNUC__)
+	return __builtin_ctz(mask);
+#elif defined(_MSC_VER)
+	unsigned long index = 0;
+	_BitScanForward(&index, mask);
+	return index;
+#else
+	unsigned int index = 0;
+	while ((mask & 1) == 0)
+	{
+		mask >>= 1;
+		index++;
+	}
+	return index;
+#endif
+}
+
+static size_t hashKey(const std::string& key)
+{
+	return std::hash<std::string>()(key);
+}
+
+//-------------------------------Iterator------------------------------
+HashMap::Iterator::Iterator(const HashMap* map, unsigned int index)
+	:_map(map)
+	,_index(index)
+{
+	this->skip();
+}
+
+const std::string& HashMap::Iterator::key() const
+{
+	return _map->_slots[_index].key;
+}
+
+Value& HashMap::Iterator::value() const
+{
+	return _map->_slots[_index].value;
+}
+
+HashMap::Iterator& HashMap::Iterator::operator++()
+{
+	_index++;
+	this->skip();
+	return *this;
+}
+
+void HashMap::Iterator::skip()
+{
+	while (_index < _map->_capacity && (_map->_ctrl[_index] & 0x80))
+		_index++;
+}
+//-------------------------------HashMap------------------------------
+HashMap::HashMap()
+	:_ctrl(nullptr)
+	,_slots(nullptr)
+	,_capacity(0)
+	,_size(0)
+	,_deleted(0)
+{
+}
+
+HashMap::HashMap(const HashMap& map)
+	:_ctrl(nullptr)
+	,_slots(nullptr)
+	,_capacity(0)
+	,_size(0)
+	,_deleted(0)
+{
+	*this = map;
+}
+
+HashMap::~HashMap()
+{
+	this->release();
+}
+
+HashMap& HashMap::operator=(const HashMap& map)
+{
+	if (this == &map)
+		return *this;
+
+	this->release();
+	if (map._capacity == 0)
+		return *this;
+
+	_capacity = map._capacity;
+	_ctrl = new unsigned char[_capacity];
+	_slots = new Entry[_capacity];
+	memcpy(_ctrl, map._ctrl, _capacity);
+	//λֲ䣬ֻԪصĲλ
+	for (unsigned int i = 0; i < _capacity; i++)
+	{
+		if (!(_ctrl[i] & 0x80))
+			_slots[i] = map._slots[i];
+	}
+	_size = map._size;
+	_deleted = map._deleted;
+
+	return *this;
+}
+
+bool HashMap::operator==(const HashMap& map) const
+{
+	if (_size != map._size)
+		return false;
+
+	for (auto it = this->begin(); it != this->end(); ++it)
+	{
+		Value* value = map.find(it.key());
+		if (value == nullptr || *value != it.value())
+			return false;
+	}
+	return true;
+}
+
+bool HashMap::operator!=(const HashMap& map) const
+{
+	return !(*this == map);
+}
+
+Value* HashMap::find(const std::string& key) const
+{
+	int index = this->indexOf(key, hashKey(key));
+
+	return index >= 0 ? &_slots[index].value : nullptr;
+}
+
+Value& HashMap::operator[](const std::string& key)
+{
+	size_t hash = hashKey(key);
+	int index = this->indexOf(key, hash);
+
+	if (index >= 0)
+		return _slots[index].value;
+	//س7/8ʱؽԪسһʱݣֻɾ
+	if (_capacity == 0)
+		this->rehash(GROUP_SIZE);
+	else if ((_size + _deleted + 1) * 8 > _capacity * 7)
+		this->rehash((_size + 1) * 2 > _capacity ? _capacity * 2 : _capacity);
+
+	unsigned int slot = this->freeSlot(hash);
+	if (_ctrl[slot] == CTRL_DELETED)
+		_deleted--;
+	_ctrl[slot] = hash & 0x7F;
+	_slots[slot].key = key;
+	_size++;
+
+	return _slots[slot].value;
+}
+
+bool HashMap::erase(const std::string& key)
+{
+	int index = this->indexOf(key, hashKey(key));
+
+	if (index < 0)
+		return false;
+	//ڻпղʱҲԽ飬ֱӱΪ
+	const unsigned char* group = _ctrl + index / GROUP_SIZE * GROUP_SIZE;
+	if (matchByte(group, CTRL_EMPTY) != 0)
+		_ctrl[index] = CTRL_EMPTY;
+	else
+	{
+		_ctrl[index] = CTRL_DELETED;
+		_deleted++;
+	}
+	_slots[index].key.clear();
+	_slots[index].value = Value::Null;
+	_size--;
+
+	return true;
+}
+
+void HashMap::clear()
+{
+	this->release();
+}
+
+void HashMap::reserve(unsigned int count)
+{
+	unsigned int capacity = GROUP_SIZE;
+	//ָزһ
+	while (capacity < count * 2)
+		capacity *= 2;
+	if (capacity > _capacity)
+		this->rehash(capacity);
+}
+
+HashMap::Iterator HashMap::begin() const
+{
+	return Iterator(this, 0);
+}
+
+HashMap::Iterator HashMap::end() const
+{
+	return Iterator(this, _capacity);
+}
+
+int HashMap::indexOf(const std::string& key, size_t hash) const
+{
+	if (_capacity == 0)
+		return -1;
+
+	unsigned char h2 = hash & 0x7F;
+	unsigned int groups = _capacity / GROUP_SIZE;
+	unsigned int g = (hash >> 7) & (groups - 1);
+	//̽⣬Ϊ2ʱ
+	for (unsigned int step = 1; step <= groups; step++)
+	{
+		const unsigned char* group = _ctrl + g * GROUP_SIZE;
+		unsigned int mask = matchByte(group, h2);
+
+		while (mask != 0)
+		{
+			unsigned int index = g * GROUP_SIZE + lowestBit(mask);
+			if (_slots[index].key == key)
+				return index;
+			mask &= mask - 1;
+		}
+		//пղۣ
+		if (matchByte(group, CTRL_EMPTY) != 0)
+			return -1;
+		g = (g + step) & (groups - 1);
+	}
+	return -1;
+}
+
+unsigned int HashMap::freeSlot(size_t hash) const
+{
+	unsigned int groups = _capacity / GROUP_SIZE;
+	unsigned int g = (hash >> 7) & (groups - 1);
+
+	for (unsigned int step = 1; ; step++)
+	{
+		unsigned int mask = matchFree(_ctrl + g * GROUP_SIZE);
+		//ӱ֤һҵ
+		if (mask != 0)
+			return g * GROUP_SIZE + lowestBit(mask);
+		g = (g + step) & (groups - 1);
+	}
+}
+
+void HashMap::rehash(unsigned int capacity)
+{
+	unsigned char* oldCtrl = _ctrl;
+	Entry* oldSlots = _slots;
+	unsigned int oldCapacity = _capacity;
+
+	_capacity = capacity;
+	_ctrl = new unsigned char[capacity];
+	_slots = new Entry[capacity];
+	_deleted = 0;
+	memset(_ctrl, CTRL_EMPTY, capacity);
+
+	for (unsigned int i = 0; i < oldCapacity; i++)
+	{
+		if (oldCtrl[i] & 0x80)
+			continue;
+		size_t hash = hashKey(oldSlots[i].key);
+		unsigned int slot = this->freeSlot(hash);
+
+		_ctrl[slot] = hash & 0x7F;
+		_slots[slot].key = std::move(oldSlots[i].key);
+		_slots[slot].value = std::move(oldSlots[i].value);
+	}
+	delete[] oldCtrl;
+	delete[] oldSlots;
+}
+
+void HashMap::release()
+{
+	delete[] _ctrl;
+	delete[] _slots;
+	_ctrl = nullptr;
+	_slots = nullptr;
+	_capacity = 0;
+	_size = 0;
+	_deleted = 0;
+}
+NS_STONE_END
\ No newline at end of file
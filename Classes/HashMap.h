@@ -0,0 +1,81 @@
+#ifndef __Stone_HashMap_H__
+#define __Stone_HashMap_H__
+
+#include <string>
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class Value;
+
+/*
+	ַΪĿѰַϣڽűеmap
+	ÿλһֽڵĿλղΪEMPTYɾΪDELETEDΪϣֵĵ7λ
+	ʱ16λΪһȽϿλ֧SSE2ʱһαȽ
+*/
+class HashMap
+{
+public:
+	//Ԫأ˳򲻹̶
+	class Iterator
+	{
+	public:
+		Iterator(const HashMap* map, unsigned int index);
+
+		const std::string& key() const;
+		Value& value() const;
+
+		Iterator& operator++();
+		bool operator==(const Iterator& it) const { return _index == it._index; }
+		bool operator!=(const Iterator& it) const { return _index != it._index; }
+	private:
+		//һԪصĲλ
+		void skip();
+	private:
+		const HashMap* _map;
+		unsigned int _index;
+	};
+public:
+	HashMap();
+	HashMap(const HashMap& map);
+	~HashMap();
+
+	HashMap& operator=(const HashMap& map);
+	bool operator==(const HashMap& map) const;
+	bool operator!=(const HashMap& map) const;
+
+	unsigned int size() const { return _size; }
+	bool empty() const { return _size == 0; }
+	//ҼӦֵ򷵻nullptr
+	Value* find(const std::string& key) const;
+	//ȡӦֵֵ
+	Value& operator[](const std::string& key);
+	//ɾǷ
+	bool erase(const std::string& key);
+	void clear();
+	//ԤȷcountԪصĿռ
+	void reserve(unsigned int count);
+
+	Iterator begin() const;
+	Iterator end() const;
+private:
+	struct Entry;
+	//ҼڵĲλ򷵻-1
+	int indexOf(const std::string& key, size_t hash) const;
+	//ҵԲĲλ
+	unsigned int freeSlot(size_t hash) const;
+	//²Ԫ
+	void rehash(unsigned int capacity);
+	void release();
+private:
+	unsigned char* _ctrl;
+	Entry* _slots;
+	//λΪ0162ݱ
+	unsigned int _capacity;
+	unsigned int _size;
+	//ΪɾĲλ
+	unsigned int _deleted;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include <climits>
+
+#include "IONatives.h"
+#include "Environment.h"
+#include "StoneException.h"
+#include "Function.h"
+#include "EventLoop.h"
+#include "TaskPool.h"
+
+NS_STONE_BEGIN
+
+typedef void (*IONative)(EventLoop* loop, Value* args, Value* ret);
+
+//󶨵¼ѭûгнʹ
+static void putIONative(Environment* env, EventLoop* loop, const std::string& name, IONative func, int len)
+{
+	env->putNative(name, [loop, func](Value* args, unsigned int argc, Value* ret) {
+		if (TaskPool::isInTask())
+			throw StoneException("async I/O is not available in parallel tasks");
+		func(loop, args, ret);
+	}, len);
+}
+
+static int getFd(const Value& value)
+{
+	if (!value.isInteger() || value.asLong() < 0 || value.asLong() > INT_MAX)
+		throw StoneException("bad fd");
+	return (int)value.asLong();
+}
+
+static Function* getFunction(const Value& value)
+{
+	if (value.getType() != Value::Type::FUNCTION)
+		throw StoneException("bad function");
+	return value.asFunction();
+}
+
+static unsigned int getInterval(const Value& value)
+{
+	if (!value.isInteger() || value.asLong() < 0 || value.asLong() > UINT_MAX)
+		throw StoneException("bad interval");
+	return (unsigned int)value.asLong();
+}
+
+//open(path, mode) ļmodeΪ"r" "w" "a"
+static void open(EventLoop* loop, Value* args, Value* ret)
+{
+	*ret = Value(loop->open(args[0].asString(), args[1].asString()));
+}
+
+//pipe() {, д}
+static void pipe(EventLoop* loop, Value* args, Value* ret)
+{
+	int fds[2];
+	loop->pipe(fds);
+	ValueVector list;
+	list.push_back(Value(fds[0]));
+	list.push_back(Value(fds[1]));
+	*ret = Value(list);
+}
+
+//connect(path) unix socket
+static void connect(EventLoop* loop, Value* args, Value* ret)
+{
+	*ret = Value(loop->connect(args[0].asString()));
+}
+
+//listen(path, f) unix socketÿӵf(fd)
+static void listen(EventLoop* loop, Value* args, Value* ret)
+{
+	*ret = Value(loop->listen(args[0].asString(), getFunction(args[1])));
+}
+
+//timer(ms, f) msһf
+static void timer(EventLoop* loop, Value* args, Value* ret)
+{
+	*ret = Value(loop->addTimer(getInterval(args[0]), false, getFunction(args[1])));
+}
+
+//ticker(ms, f) ÿmsfֱfclose
+static void ticker(EventLoop* loop, Value* args, Value* ret)
+{
+	unsigned int ms = getInterval(args[0]);
+	if (ms == 0)
+		throw StoneException("bad interval");
+	*ret = Value(loop->addTimer(ms, true, getFunction(args[1])));
+}
+
+//onread(fd, f) ɶʱf(data, 0)ʱһf("", 1)
+static void onread(EventLoop* loop, Value* args, Value* ret)
+{
+	Function* callback = getFunction(args[1]);
+	if (callback->getParamSize() != 2)
+		throw StoneException("bad number of arguments");
+	loop->read(getFd(args[0]), callback);
+}
+
+//write(fd, data, f) дdataдf(n)
+static void write(EventLoop* loop, Value* args, Value* ret)
+{
+	Function* callback = nullptr;
+	if (args[2].getType() == Value::Type::FUNCTION)
+		callback = args[2].asFunction();
+	loop->write(getFd(args[0]), args[1].asString(), callback);
+}
+
+//fclose(fd) ȡصرգҲֹͣʱ
+static void fclose(EventLoop* loop, Value* args, Value* ret)
+{
+	loop->close(getFd(args[0]));
+}
+
+void registerIONatives(Environment* env, EventLoop* loop)
+{
+	putIONative(env, loop, "open", open, 2);
+	putIONative(env, loop, "pipe", pipe, 0);
+	putIONative(env, loop, "connect", connect, 1);
+	putIONative(env, loop, "listen", listen, 2);
+	putIONative(env, loop, "timer", timer, 2);
+	putIONative(env, loop, "ticker", ticker, 2);
+	putIONative(env, loop, "onread", onread, 2);
+	putIONative(env, loop, "write", write, 3);
+	putIONative(env, loop, "fclose", fclose, 1);
+}
+NS_STONE_END
\ No newline at end of file
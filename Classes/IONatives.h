@@ -0,0 +1,21 @@
+#ifndef __Stone_IONatives_H__
+#define __Stone_IONatives_H__
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class Environment;
+class EventLoop;
+
+/*
+	첽I/Oıغ open pipe connect listen timer ticker onread write fclose
+	ʾдɺĻص¼ѭִУűнInterpreter::runLoop
+	onread(fd, f)ÿζʱf(data)ʱf(null)
+	write(fd, data, f)дf(n)fǺʱص
+	pmapȲвʹ
+*/
+void registerIONatives(Environment* env, EventLoop* loop);
+
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include "Interpreter.h"
+#include "Lexer.h"
+#include "Token.h"
+#include "Parser.h"
+#include "ASTree.h"
+#include "NestedEnv.h"
+#include "EvalVisitor.h"
+#include "Function.h"
+#include "StoneException.h"
+#include "ArrayNatives.h"
+#include "MapNatives.h"
+#include "MathNatives.h"
+#include "ParallelNatives.h"
+#include "TaskNatives.h"
+#include "GeneratorNatives.h"
+#include "IONatives.h"
+#include "OutputNatives.h"
+#include "StringNatives.h"
+#include "TaskGroup.h"
+#include "EventLoop.h"
+#include "OutputBuffer.h"
+#include "STAutoreleasePool.h"
+
+NS_STONE_BEGIN
+
+Interpreter::Interpreter()
+	:_env(new NestedEnv())
+	,_visitor(new EvalVisitor())
+	,_parser(new Parser())
+	,_pool(new AutoreleasePool())
+	,_group(new TaskGroup())
+	,_loop(new EventLoop())
+	,_output(new OutputBuffer())
+{
+	registerArrayNatives(_env);
+	registerMapNatives(_env);
+	registerMathNatives(_env);
+	registerStringNatives(_env);
+	registerParallelNatives(_env);
+	registerTaskNatives(_env);
+	registerGeneratorNatives(_env);
+	registerIONatives(_env, _loop);
+	registerOutputNatives(_env, _output);
+}
+
+Interpreter::~Interpreter()
+{
+	_result = Value::Null;
+	//ͷųеĶû
+	_pool->clear();
+	delete _pool;
+	//رͷŻص
+	delete _loop;
+	delete _group;
+	delete _visitor;
+	delete _parser;
+	//ȫֻγѭãձͷ
+	//ԳеĺûǱͷ
+	_env->clear();
+	_env->release();
+	//дʣ
+	delete _output;
+}
+
+Environment* Interpreter::getEnvironment() const
+{
+	return _env;
+}
+
+void Interpreter::run(const char* code, const StatementCallback& callback)
+{
+	Lexer lexer(code);
+	//ڼԶͷŵĶ뱾ʵͷų
+	AutoreleasePool* previous = AutoreleasePool::setInstance(_pool);
+	_parser->setLexer(&lexer);
+	_group->acquire();
+
+	try
+	{
+		while (lexer.peek(0) != Token::TOKEN_EOF)
+		{
+			ASTree* t = _parser->parse();
+
+			if (t != nullptr)
+			{
+				try
+				{
+					t->accept(_visitor, _env);
+					_result = *_visitor->result;
+					if (callback != nullptr)
+						callback(t, _result);
+				}
+				catch (...)
+				{
+					t->release();
+					throw;
+				}
+				t->release();
+			}
+			_pool->clear();
+		}
+		if (_loop->isEmpty())
+			_group->waitAll(false);
+	}
+	catch (...)
+	{
+		//űʱȡе
+		_group->waitAll(true);
+		//ǰд
+		_output->flush();
+		_group->release();
+		_pool->clear();
+		_parser->setLexer(nullptr);
+		AutoreleasePool::setInstance(previous);
+		throw;
+	}
+	_group->release();
+	_parser->setLexer(nullptr);
+	AutoreleasePool::setInstance(previous);
+}
+
+void Interpreter::runLoop()
+{
+	AutoreleasePool* previous = AutoreleasePool::setInstance(_pool);
+	_group->acquire();
+
+	try
+	{
+		while (true)
+		{
+			//ڽǰעµI/O
+			if (_loop->isEmpty())
+			{
+				_group->waitAll(false);
+				if (_loop->isEmpty())
+					break;
+			}
+			//ȴ¼ǰдص֮Ȼϲ
+			_output->flush();
+			_loop->runOnce(_visitor, _group);
+			_pool->clear();
+		}
+	}
+	catch (...)
+	{
+		_group->waitAll(true);
+		_output->flush();
+		_group->release();
+		_pool->clear();
+		AutoreleasePool::setInstance(previous);
+		throw;
+	}
+	_group->release();
+	AutoreleasePool::setInstance(previous);
+}
+
+Function* Interpreter::getFunction(const std::string& name) const
+{
+	const Value* value = _env->get(name);
+	if (value == nullptr || value->getType() != Value::Type::FUNCTION)
+		throw StoneException("undefined function: " + name);
+	return value->asFunction();
+}
+
+void Interpreter::invokeEach(Function* function, const ArgumentSource& next, const ResultCallback& callback)
+{
+	AutoreleasePool* previous = AutoreleasePool::setInstance(_pool);
+	_group->acquire();
+	Value arg;
+
+	try
+	{
+		while (next(arg))
+		{
+			callback(_visitor->invoke(function, &arg, 1));
+			_pool->clear();
+		}
+	}
+	catch (...)
+	{
+		_group->waitAll(true);
+		_output->flush();
+		_group->release();
+		_pool->clear();
+		AutoreleasePool::setInstance(previous);
+		throw;
+	}
+	_group->release();
+	AutoreleasePool::setInstance(previous);
+}
+NS_STONE_END
\ No newline at end of file
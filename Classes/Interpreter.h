@@ -0,0 +1,71 @@
+#ifndef __Stone_Interpreter_H__
+#define __Stone_Interpreter_H__
+
+#include <functional>
+
+#include "Value.h"
+
+NS_STONE_BEGIN
+
+class ASTree;
+class Environment;
+class NestedEnv;
+class EvalVisitor;
+class Parser;
+class AutoreleasePool;
+class TaskGroup;
+class EventLoop;
+class Function;
+class OutputBuffer;
+
+/*
+	ʵӵԼ﷨ȫִֻԶͷų
+	ʵ֮ûйĿɱ״̬ͬʵڲͬ߳ͬʱ
+	ͬһʵͬһʱֻһ߳ʹãűspawn߳н
+	űע첽I/Oصrun֮runLoopִ
+	printȵдʵ壬ʱʱд
+*/
+class Interpreter
+{
+public:
+	//ÿִкãΪ
+	typedef std::function<void(ASTree* statement, const Value& result)> StatementCallback;
+	//ṩһεõĲûиʱfalse
+	typedef std::function<bool(Value& arg)> ArgumentSource;
+	//ÿεú
+	typedef std::function<void(const Value& result)> ResultCallback;
+public:
+	//ȫֻ顢mapֵСI/Oıغ
+	Interpreter();
+	virtual ~Interpreter();
+
+	//ȫֻǰӱغ
+	Environment* getEnvironment() const;
+	//壬ҲӦдԱ˳
+	OutputBuffer* getOutput() const { return _output; }
+	//ִнűʱ׳ParseExceptionStoneException
+	//ȫֱڶ֮䱣ǰȴűȫ
+	//еȴеI/OʱصʱȴrunLoopȴ
+	void run(const char* code, const StatementCallback& callback = nullptr);
+	//¼ѭֱûеȴеI/Oʱ񣬻صʱ׳StoneException
+	void runLoop();
+	//ȡȫֻеĺڻ߲Ǻʱ׳StoneException
+	Function* getFunction(const std::string& name) const;
+	//run֮nextṩÿõĺ½ÿֻ֡
+	//ڼһֱнִֻóʱл
+	//ȴд񣬳ʱȡ׳StoneException
+	void invokeEach(Function* function, const ArgumentSource& next, const ResultCallback& callback);
+	//һĽ
+	const Value& getResult() const { return _result; }
+private:
+	NestedEnv* _env;
+	EvalVisitor* _visitor;
+	Parser* _parser;
+	AutoreleasePool* _pool;
+	TaskGroup* _group;
+	EventLoop* _loop;
+	OutputBuffer* _output;
+	Value _result;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
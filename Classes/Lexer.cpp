@@ -4,7 +4,7 @@
 
 NS_STONE_BEGIN
 
-std::string Lexer::REGEX_POT = "\\s*((//.*)|([0-9]+)|(\"(\\\\\"|\\\\\\\\|\\\\n|[^\"])*\")|[A-Z_a-z][A-Z_a-z0-9]*|==|!=|<=|>=|[\\{\\}<>=;+\\-\\*/%()\\,\\[\\]])?";
+const std::string Lexer::REGEX_POT = "\\s*((//.*)|([0-9]+(?:\\.[0-9]+)?)|(\"(\\\\\"|\\\\\\\\|\\\\n|[^\"])*\")|[A-Z_a-z][A-Z_a-z0-9]*|==|!=|<=|>=|[\\{\\}<>=;:+\\-\\*/%()\\,\\[\\]])?";
 
 
 Lexer::Lexer(const char* buffer)
@@ -73,9 +73,9 @@ void Lexer::addToken(int lineNo, std::cmatch& matcher) {
 		//ƥĲע
 		if (matcher[2] != m) {
 			Token* token = nullptr;
-			//
+			//֣СΪ
 			if (matcher[3] == m)
-				token = new NumToken(lineNo, std::stoi(m));
+				token = this->toNumber(lineNo, m);
 			//ַ
 			else if (matcher[4] == m)
 				token = new StrToken(lineNo, this->toStringLiteral(m));
@@ -89,6 +89,24 @@ void Lexer::addToken(int lineNo, std::cmatch& matcher) {
 	}//end if
 }
 
+Token* Lexer::toNumber(int lineNo, const std::string& s) {
+	if (s.find('.') != std::string::npos) {
+		try {
+			return new NumToken(lineNo, std::stod(s));
+		}
+		catch (const std::out_of_range&) {
+			throw ParseException("number out of range at line " + std::to_string(lineNo));
+		}
+	}
+	//int64ԭģֵʱΪ
+	try {
+		return new NumToken(lineNo, static_cast<int64_t>(std::stoll(s)));
+	}
+	catch (const std::out_of_range&) {
+		return new NumToken(lineNo, s);
+	}
+}
+
 std::string Lexer::toStringLiteral(const std::string& s) {
 	int len = s.length();
 	std::stringstream buffer;
@@ -16,7 +16,7 @@ class Token;
 class Lexer
 {
 public:
-	static std::string REGEX_POT;
+	static const std::string REGEX_POT;
 public:
 	Lexer(const char* buffer);
 	~Lexer();
@@ -28,6 +28,8 @@ protected:
 	void readLine();
 	//token
 	void addToken(int lineNo, std::cmatch& matcher);
+	//ת֣Χʱ׳쳣
+	Token* toNumber(int lineNo, const std::string& s);
 	//ַȥһЩַ
 	std::string toStringLiteral(const std::string& s);
 private:
@@ -0,0 +1,34 @@
+#include "MapLiteral.h"
+#include "Visitor.h"
+#include "Environment.h"
+
+NS_STONE_BEGIN
+MapLiteral::MapLiteral()
+{
+}
+
+MapLiteral::MapLiteral(const std::vector<ASTree*>& list)
+	:ASTList(list)
+{
+}
+
+unsigned int MapLiteral::getSize() const
+{
+	return getNumChildren() / 2;
+}
+
+ASTree* MapLiteral::getKey(unsigned int index) const
+{
+	return getChild(index * 2);
+}
+
+ASTree* MapLiteral::getValue(unsigned int index) const
+{
+	return getChild(index * 2 + 1);
+}
+
+void MapLiteral::accept(Visitor* v, Environment* env)
+{
+	v->visit(this, env);
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef __Stone_MapLiteral_H__
+#define __Stone_MapLiteral_H__
+
+#include "ASTList.h"
+
+NS_STONE_BEGIN
+
+class Visitor;
+class Environment;
+
+/*
+	mapӽڵΪֵ
+*/
+class MapLiteral : public ASTList
+{
+public:
+	MapLiteral();
+	MapLiteral(const std::vector<ASTree*>& list);
+	//ֵԵĸ
+	unsigned int getSize() const;
+	ASTree* getKey(unsigned int index) const;
+	ASTree* getValue(unsigned int index) const;
+public:
+	virtual void accept(Visitor* v, Environment* env);
+};
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "MapNatives.h"
+#include "Environment.h"
+#include "StoneException.h"
+
+NS_STONE_BEGIN
+
+typedef NativeFunction::ArgMode ArgMode;
+
+//mapļΪַתΪַ
+static std::string toKey(const Value& key)
+{
+	if (!key.isString() && key.getType() != Value::Type::INTEGER)
+		throw StoneException("bad map key");
+	return key.asString();
+}
+
+//has(m, k) ǷڼkȽһ·10
+static void has(Value* args, unsigned int argc, Value* ret)
+{
+	*ret = args[0].asValueMap().find(toKey(args[1])) != nullptr ? 1 : 0;
+}
+
+//delete(m, k) ɾkرɾֵ
+static void erase(Value* args, unsigned int argc, Value* ret)
+{
+	auto& map = args[0].asValueMap();
+	std::string key = toKey(args[1]);
+	Value* value = map.find(key);
+
+	if (value != nullptr)
+	{
+		*ret = std::move(*value);
+		map.erase(key);
+	}
+}
+
+//keys(m) ȡмɵ
+static void keys(Value* args, unsigned int argc, Value* ret)
+{
+	auto& map = args[0].asValueMap();
+	Value list = Value(ValueVector());
+	auto& vector = list.asValueVector();
+
+	vector.reserve(map.size());
+	for (auto it = map.begin(); it != map.end(); ++it)
+		vector.push_back(Value(it.key()));
+	*ret = std::move(list);
+}
+
+//values(m) ȡֵɵ飬˳keysͬ
+static void values(Value* args, unsigned int argc, Value* ret)
+{
+	auto& map = args[0].asValueMap();
+	Value list = Value(ValueVector());
+	auto& vector = list.asValueVector();
+
+	vector.reserve(map.size());
+	for (auto it = map.begin(); it != map.end(); ++it)
+		vector.push_back(it.value());
+	*ret = std::move(list);
+}
+
+void registerMapNatives(Environment* env)
+{
+	//mapô룬Ḵ
+	env->putNative("delete", erase, 2, ArgMode::WRITE);
+	env->putNative("has", has, 2, ArgMode::READ);
+	env->putNative("keys", keys, 1, ArgMode::READ);
+	env->putNative("values", values, 1, ArgMode::READ);
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,17 @@
+#ifndef __Stone_MapNatives_H__
+#define __Stone_MapNatives_H__
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class Environment;
+
+/*
+	mapصıغ has delete keys values
+	mapô룬ֱ޸ĵ߱еmap
+*/
+void registerMapNatives(Environment* env);
+
+NS_STONE_END
+#endif
\ No newline at end of file
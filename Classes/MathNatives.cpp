@@ -0,0 +1,279 @@
+#include <algorithm>
+
+#include "MathNatives.h"
+#include "Environment.h"
+#include "StoneException.h"
+#include "VectorKernels.h"
+#include "PackedArray.h"
+#include "BigInt.h"
+
+NS_STONE_BEGIN
+
+typedef PackedArray::Kind Kind;
+typedef NativeFunction::ArgMode ArgMode;
+
+//ȡͼԪأ
+static void getArray(const Value& value, const Value*& data, unsigned int& size)
+{
+	if (!value.getElements(data, size))
+		throw StoneException("bad array");
+}
+
+//------------------------------Ԫؼ------------------------------
+//computeOpĹһ£ʱΪиʱΪdouble
+static Value addValue(const Value& left, const Value& right)
+{
+	if (left.isInteger() && right.isInteger())
+		return BigInt::add(left, right);
+	if (!left.isNumber() || !right.isNumber())
+		throw StoneException("bad array element");
+	return Value(left.asDouble() + right.asDouble());
+}
+
+static Value multiplyValue(const Value& left, const Value& right)
+{
+	if (left.isInteger() && right.isInteger())
+		return BigInt::multiply(left, right);
+	if (!left.isNumber() || !right.isNumber())
+		throw StoneException("bad array element");
+	return Value(left.asDouble() * right.asDouble());
+}
+
+static int compareValue(const Value& left, const Value& right)
+{
+	if (left.isInteger() && right.isInteger())
+		return BigInt::compare(left, right);
+	if (!left.isNumber() || !right.isNumber())
+		throw StoneException("bad array element");
+	double a = left.asDouble(), b = right.asDouble();
+	return a < b ? -1 : (a > b ? 1 : 0);
+}
+//------------------------------natives------------------------------
+//sum(a) Ԫ֮
+static void sum(Value* args, unsigned int argc, Value* ret)
+{
+	const Value* data = nullptr;
+	unsigned int size = 0;
+	PackedArray packed;
+	auto& kernels = VectorKernels::getInstance();
+
+	getArray(args[0], data, size);
+	packed.pack(data, size);
+
+	if (packed.getKind() == Kind::LONG && PackedArray::fitsLong(packed.getMaxAbs(), 1, size))
+		*ret = Value(kernels.sumLong(packed.getLongs(), size));
+	else if (packed.getKind() == Kind::DOUBLE)
+		*ret = Value(kernels.sumDouble(packed.getDoubles(), size));
+	else
+	{
+		Value value = Value(0);
+		for (unsigned int i = 0; i < size; i++)
+			value = addValue(value, data[i]);
+		*ret = std::move(value);
+	}
+}
+
+//СԪأsignΪ1ʱֵ
+static void extremum(Value* args, Value* ret, int sign)
+{
+	const Value* data = nullptr;
+	unsigned int size = 0;
+	PackedArray packed;
+	auto& kernels = VectorKernels::getInstance();
+
+	getArray(args[0], data, size);
+	if (size == 0)
+		throw StoneException("empty array");
+	packed.pack(data, size);
+
+	if (packed.getKind() == Kind::LONG)
+		*ret = Value(sign > 0 ? kernels.maxLong(packed.getLongs(), size) : kernels.minLong(packed.getLongs(), size));
+	else if (packed.getKind() == Kind::DOUBLE)
+		*ret = Value(sign > 0 ? kernels.maxDouble(packed.getDoubles(), size) : kernels.minDouble(packed.getDoubles(), size));
+	else
+	{
+		unsigned int index = 0;
+		for (unsigned int i = 1; i < size; i++)
+		{
+			if (compareValue(data[i], data[index]) * sign > 0)
+				index = i;
+		}
+		*ret = data[index];
+	}
+}
+
+//min(a) СԪ
+static void min(Value* args, unsigned int argc, Value* ret)
+{
+	extremum(args, ret, -1);
+}
+
+//max(a) Ԫ
+static void max(Value* args, unsigned int argc, Value* ret)
+{
+	extremum(args, ret, 1);
+}
+
+//dot(a, b) ĳȱͬ
+static void dot(Value* args, unsigned int argc, Value* ret)
+{
+	const Value* left = nullptr;
+	const Value* right = nullptr;
+	unsigned int size = 0, otherSize = 0;
+	PackedArray a, b;
+	auto& kernels = VectorKernels::getInstance();
+
+	getArray(args[0], left, size);
+	getArray(args[1], right, otherSize);
+	if (size != otherSize)
+		throw StoneException("array size mismatch");
+	a.pack(left, size);
+	b.pack(right, size);
+
+	if (a.getKind() == Kind::LONG && b.getKind() == Kind::LONG && PackedArray::fitsLong(a.getMaxAbs(), b.getMaxAbs(), size))
+		*ret = Value(kernels.dotLong(a.getLongs(), b.getLongs(), size));
+	else if (a.getKind() != Kind::OTHER && b.getKind() != Kind::OTHER
+		&& (a.getKind() == Kind::DOUBLE || b.getKind() == Kind::DOUBLE))
+	{
+		a.promote();
+		b.promote();
+		*ret = Value(kernels.dotDouble(a.getDoubles(), b.getDoubles(), size));
+	}
+	else
+	{
+		Value value = Value(0);
+		for (unsigned int i = 0; i < size; i++)
+			value = addValue(value, multiplyValue(left[i], right[i]));
+		*ret = std::move(value);
+	}
+}
+
+//fill(a, v) ԪΪv
+static void fill(Value* args, unsigned int argc, Value* ret)
+{
+	auto& list = args[0].asValueVector();
+	std::fill(list.begin(), list.end(), args[1]);
+}
+
+//scale(a, k) ÿԪسk
+static void scale(Value* args, unsigned int argc, Value* ret)
+{
+	const Value* data = nullptr;
+	unsigned int size = 0;
+	PackedArray packed;
+	const Value& factor = args[1];
+	auto& kernels = VectorKernels::getInstance();
+
+	getArray(args[0], data, size);
+	packed.pack(data, size);
+
+	if (packed.getKind() == Kind::LONG && factor.getType() == Value::Type::INTEGER
+		&& PackedArray::fitsLong(packed.getMaxAbs(), factor.asLong() < 0 ? 0 - (uint64_t)factor.asLong() : (uint64_t)factor.asLong(), 1))
+	{
+		kernels.scaleLong(packed.getLongs(), size, factor.asLong());
+		*ret = packed.toValue();
+	}
+	else if (packed.getKind() != Kind::OTHER
+		&& (PackedArray::isFloating(factor) || (packed.getKind() == Kind::DOUBLE && factor.getType() == Value::Type::INTEGER)))
+	{
+		packed.promote();
+		kernels.scaleDouble(packed.getDoubles(), size, factor.asDouble());
+		*ret = packed.toValue();
+	}
+	else
+	{
+		Value value = Value(ValueVector());
+		auto& list = value.asValueVector();
+
+		list.reserve(size);
+		for (unsigned int i = 0; i < size; i++)
+			list.push_back(multiplyValue(data[i], factor));
+		*ret = std::move(value);
+	}
+}
+
+//add(a, b) ضӦԪӵ飬ĳȱͬ
+static void add(Value* args, unsigned int argc, Value* ret)
+{
+	const Value* left = nullptr;
+	const Value* right = nullptr;
+	unsigned int size = 0, otherSize = 0;
+	PackedArray a, b;
+	auto& kernels = VectorKernels::getInstance();
+
+	getArray(args[0], left, size);
+	getArray(args[1], right, otherSize);
+	if (size != otherSize)
+		throw StoneException("array size mismatch");
+	a.pack(left, size);
+	b.pack(right, size);
+
+	if (a.getKind() == Kind::LONG && b.getKind() == Kind::LONG && PackedArray::fitsLong(std::max(a.getMaxAbs(), b.getMaxAbs()), 2, 1))
+	{
+		kernels.addLong(a.getLongs(), b.getLongs(), size);
+		*ret = a.toValue();
+	}
+	else if (a.getKind() != Kind::OTHER && b.getKind() != Kind::OTHER)
+	{
+		a.promote();
+		b.promote();
+		kernels.addDouble(a.getDoubles(), b.getDoubles(), size);
+		*ret = a.toValue();
+	}
+	else
+	{
+		Value value = Value(ValueVector());
+		auto& list = value.asValueVector();
+
+		list.reserve(size);
+		for (unsigned int i = 0; i < size; i++)
+			list.push_back(addValue(left[i], right[i]));
+		*ret = std::move(value);
+	}
+}
+
+//count(a, v) vԪظֵСȽ
+static void count(Value* args, unsigned int argc, Value* ret)
+{
+	const Value* data = nullptr;
+	unsigned int size = 0;
+	PackedArray packed;
+	const Value& value = args[1];
+	auto& kernels = VectorKernels::getInstance();
+
+	getArray(args[0], data, size);
+	packed.pack(data, size);
+
+	size_t n = 0;
+	if (packed.getKind() == Kind::LONG && value.getType() == Value::Type::INTEGER)
+		n = kernels.countLong(packed.getLongs(), size, value.asLong());
+	else if (packed.getKind() != Kind::OTHER
+		&& (PackedArray::isFloating(value) || (packed.getKind() == Kind::DOUBLE && value.getType() == Value::Type::INTEGER)))
+	{
+		packed.promote();
+		n = kernels.countDouble(packed.getDoubles(), size, value.asDouble());
+	}
+	else
+	{
+		for (unsigned int i = 0; i < size; i++)
+		{
+			if (data[i].isNumber() && value.isNumber() ? compareValue(data[i], value) == 0 : data[i] == value)
+				n++;
+		}
+	}
+	*ret = Value((int64_t)n);
+}
+
+void registerMathNatives(Environment* env)
+{
+	//鰴ô룬Ḵƣֻfill޸
+	env->putNative("fill", fill, 2, ArgMode::WRITE);
+	env->putNative("sum", sum, 1, ArgMode::READ);
+	env->putNative("min", min, 1, ArgMode::READ);
+	env->putNative("max", max, 1, ArgMode::READ);
+	env->putNative("dot", dot, 2, ArgMode::READ);
+	env->putNative("scale", scale, 2, ArgMode::READ);
+	env->putNative("add", add, 2, ArgMode::READ);
+	env->putNative("count", count, 2, ArgMode::READ);
+}
+NS_STONE_END
\ No newline at end of file
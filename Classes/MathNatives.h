@@ -0,0 +1,18 @@
+#ifndef __Stone_MathNatives_H__
+#define __Stone_MathNatives_H__
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class Environment;
+
+/*
+	ֵıغ sum min max dot fill scale add count
+	ԪȫΪ߸ʱƵĻУʹVectorKernels㣬
+	д߿ʱԪؼ
+*/
+void registerMathNatives(Environment* env);
+
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -6,6 +6,8 @@ NS_STONE_BEGIN
 
 Name::Name(Token* token)
 	:ASTLeaf(token)
+	,_upvalueIndex(-1)
+	,_slotIndex(-1)
 {
 }
 
@@ -15,8 +15,17 @@ public:
 	Name(Token* token);
 
 	std::string getName() const;
+	//ȡɱе-1ʾɱ
+	int getUpvalueIndex() const { return _upvalueIndex; }
+	void setUpvalueIndex(int index) { _upvalueIndex = index; }
+	//ȡջ֡е-1ʾջ֡
+	int getSlotIndex() const { return _slotIndex; }
+	void setSlotIndex(int index) { _slotIndex = index; }
 public:
 	virtual void accept(Visitor* v, Environment* env);
+private:
+	int _upvalueIndex;
+	int _slotIndex;
 };
 
 NS_STONE_END
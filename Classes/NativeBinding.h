@@ -0,0 +1,256 @@
+#ifndef __Stone_NativeBinding_H__
+#define __Stone_NativeBinding_H__
+
+#include <string>
+#include <climits>
+#include <type_traits>
+
+#include "Value.h"
+#include "NativeFunction.h"
+#include "StoneException.h"
+
+NS_STONE_BEGIN
+
+class Function;
+
+/*
+	C++Value֮תfromѲתΪC++ͣtoѷֵתΪValue
+	fromʽתͲʱ׳쳣indexΪλ(0ʼ)
+	δػ޷󶨣ʱ
+*/
+template<typename T>
+struct ValueTraits;
+
+//ͲڼӦΪʲô
+inline void throwBadArgument(unsigned int index, const char* type)
+{
+	throw StoneException("argument " + std::to_string(index + 1) + " is not " + type);
+}
+
+template<>
+struct ValueTraits<Value>
+{
+	static const Value& from(const Value& v, unsigned int index) { return v; }
+	static Value to(const Value& v) { return v; }
+};
+
+template<>
+struct ValueTraits<unsigned char>
+{
+	static unsigned char from(const Value& v, unsigned int index)
+	{
+		if (v.getType() != Value::Type::BYTE && (v.getType() != Value::Type::INTEGER || v.asLong() < 0 || v.asLong() > UCHAR_MAX))
+			throwBadArgument(index, "a byte");
+		return v.asByte();
+	}
+	static Value to(unsigned char v) { return Value(v); }
+};
+
+template<>
+struct ValueTraits<int>
+{
+	static int from(const Value& v, unsigned int index)
+	{
+		//intΧʱض
+		if (v.getType() != Value::Type::INTEGER || v.asLong() < INT_MIN || v.asLong() > INT_MAX)
+			throwBadArgument(index, "an int");
+		return v.asInt();
+	}
+	static Value to(int v) { return Value(v); }
+};
+
+template<>
+struct ValueTraits<int64_t>
+{
+	static int64_t from(const Value& v, unsigned int index)
+	{
+		if (v.getType() != Value::Type::INTEGER)
+			throwBadArgument(index, "an int");
+		return v.asLong();
+	}
+	static Value to(int64_t v) { return Value(v); }
+};
+
+template<>
+struct ValueTraits<float>
+{
+	static float from(const Value& v, unsigned int index)
+	{
+		if (!v.isNumber())
+			throwBadArgument(index, "a number");
+		return v.asFloat();
+	}
+	static Value to(float v) { return Value(v); }
+};
+
+template<>
+struct ValueTraits<double>
+{
+	static double from(const Value& v, unsigned int index)
+	{
+		if (!v.isNumber())
+			throwBadArgument(index, "a number");
+		return v.asDouble();
+	}
+	static Value to(double v) { return Value(v); }
+};
+
+template<>
+struct ValueTraits<bool>
+{
+	static bool from(const Value& v, unsigned int index)
+	{
+		//ȽĽΪ
+		if (v.getType() != Value::Type::BOOLEAN && v.getType() != Value::Type::INTEGER)
+			throwBadArgument(index, "a bool");
+		return v.asBool();
+	}
+	static Value to(bool v) { return Value(v); }
+};
+
+template<>
+struct ValueTraits<std::string>
+{
+	static std::string from(const Value& v, unsigned int index)
+	{
+		if (!v.isString())
+			throwBadArgument(index, "a string");
+		return v.asString();
+	}
+	static Value to(const std::string& v) { return Value(v); }
+};
+
+template<>
+struct ValueTraits<const char*>
+{
+	//޷ַ֤ڣֻڷֵ
+	static Value to(const char* v) { return Value(v); }
+};
+
+template<>
+struct ValueTraits<Function*>
+{
+	static Function* from(const Value& v, unsigned int index)
+	{
+		if (v.getType() != Value::Type::FUNCTION)
+			throwBadArgument(index, "a function");
+		return v.asFunction();
+	}
+	static Value to(Function* v) { return Value(v); }
+};
+
+/*
+	ֻתΪconst ValueVector&
+	ֱͨãͼƳеԪأıߵĲ
+*/
+class VectorArg
+{
+public:
+	explicit VectorArg(const ValueVector* vector) :_vector(vector) {}
+	explicit VectorArg(ValueVector&& copy) :_vector(nullptr), _copy(std::move(copy)) {}
+
+	operator const ValueVector&() const { return _vector != nullptr ? *_vector : _copy; }
+private:
+	const ValueVector* _vector;
+	ValueVector _copy;
+};
+
+template<>
+struct ValueTraits<ValueVector>
+{
+	static VectorArg from(const Value& v, unsigned int index)
+	{
+		const Value* data = nullptr;
+		unsigned int size = 0;
+		//asValueVectorͼתΪ飬ֻͨ
+		if (v.getType() == Value::Type::VECTOR)
+			return VectorArg(&v.asValueVector());
+		if (!v.getElements(data, size))
+			throwBadArgument(index, "an array");
+		return VectorArg(ValueVector(data, data + size));
+	}
+	static Value to(const ValueVector& v) { return Value(v); }
+};
+
+template<>
+struct ValueTraits<ValueMap>
+{
+	static const ValueMap& from(const Value& v, unsigned int index)
+	{
+		if (v.getType() != Value::Type::MAP)
+			throwBadArgument(index, "a map");
+		return v.asValueMap();
+	}
+	static Value to(const ValueMap& v) { return Value(v); }
+};
+
+//±Уչ
+template<unsigned int... I>
+struct IndexSequence {};
+
+template<unsigned int N, unsigned int... I>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, I...> {};
+
+template<unsigned int... I>
+struct MakeIndexSequence<0, I...>
+{
+	typedef IndexSequence<I...> type;
+};
+
+/*
+	ݺǩɰλȡĵãڱʱȷ
+*/
+template<typename R, typename... Args>
+struct NativeInvoker
+{
+	template<typename F, unsigned int... I>
+	static void invoke(F& func, Value* args, Value* ret, IndexSequence<I...>)
+	{
+		*ret = ValueTraits<typename std::decay<R>::type>::to(
+			func(ValueTraits<typename std::decay<Args>::type>::from(args[I], I)...));
+	}
+};
+
+//޷ֵʱֵΪ
+template<typename... Args>
+struct NativeInvoker<void, Args...>
+{
+	template<typename F, unsigned int... I>
+	static void invoke(F& func, Value* args, Value* ret, IndexSequence<I...>)
+	{
+		func(ValueTraits<typename std::decay<Args>::type>::from(args[I], I)...);
+	}
+};
+
+/*
+	ӿɵöȡǩ֧ͨlambdaoperator()ĺ
+	operator()أҲģ
+*/
+template<typename F>
+struct CallableTraits : CallableTraits<decltype(&F::operator())> {};
+
+template<typename R, typename... Args>
+struct CallableTraits<R (*)(Args...)>
+{
+	typedef NativeInvoker<R, Args...> Invoker;
+	static const unsigned int arity = sizeof...(Args);
+};
+
+template<typename C, typename R, typename... Args>
+struct CallableTraits<R (C::*)(Args...)> : CallableTraits<R (*)(Args...)> {};
+
+template<typename C, typename R, typename... Args>
+struct CallableTraits<R (C::*)(Args...) const> : CallableTraits<R (*)(Args...)> {};
+
+//C++Ŀɵöװɿٵõıغ󱻸Ʊ棬Я״̬
+template<typename F>
+fastNativeFunc makeNative(F func)
+{
+	typedef CallableTraits<F> Traits;
+	return [func](Value* args, unsigned int argc, Value* ret) mutable
+	{
+		Traits::Invoker::invoke(func, args, ret, typename MakeIndexSequence<Traits::arity>::type());
+	};
+}
+NS_STONE_END
+#endif
\ No newline at end of file
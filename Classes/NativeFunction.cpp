@@ -1,5 +1,6 @@
 #include "NativeFunction.h"
 #include "EvalVisitor.h"
+#include "Environment.h"
 
 NS_STONE_BEGIN
 
@@ -7,12 +8,24 @@ NativeFunction::NativeFunction(const char* params[], int len, const nativeFunc&
 	:Function(env)
 	,_paramNum(len)
 	,_callback(callback)
+	,_mode(ArgMode::VALUE)
 {
 	int i = 0;
 	while (i < len)
 		_parameters.push_back(params[i++]);
 }
 
+NativeFunction::NativeFunction(int len, const fastNativeFunc& callback, Environment* env, ArgMode mode)
+	:Function(env)
+	,_paramNum(len)
+	,_fastCallback(callback)
+	,_mode(mode)
+{
+	//û֣ɽű޷õֵ֣ʱʹ
+	for (int i = 0; i < len; i++)
+		_parameters.push_back("$" + std::to_string(i));
+}
+
 NativeFunction::~NativeFunction()
 {
 }
@@ -29,7 +42,17 @@ std::string NativeFunction::getParamName(unsigned index) const
 
 void NativeFunction::execute(Visitor* v, Environment* env)
 {
-	Value value = _callback(env);
-	static_cast<EvalVisitor*>(v)->setResult(value);
+	Value value;
+	//ȡٵ
+	if (this->isFast())
+	{
+		std::vector<Value> args;
+		for (int i = 0; i < _paramNum; i++)
+			args.push_back(*env->get(_parameters[i]));
+		this->call(args.data(), &value);
+	}
+	else
+		value = _callback(env);
+	static_cast<EvalVisitor*>(v)->setResult(std::move(value));
 }
 NS_STONE_END
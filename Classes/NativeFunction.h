@@ -13,12 +13,33 @@ NS_STONE_BEGIN
 class Environment;
 class Visitor;
 typedef std::function<Value(Environment*)> nativeFunc;
+//ٵãλ룬ֵдret(ĬΪֵ)ʱ
+typedef std::function<void(Value* args, unsigned int argc, Value* ret)> fastNativeFunc;
 
 class NativeFunction : public Function
 {
+public:
+	//׸Ĵ뷽ʽ
+	enum class ArgMode
+	{
+		//ƴ
+		VALUE,
+		//ֻãƣκηʽ޸ĸò
+		READ,
+		//ô룬޸Ļдصߵı
+		WRITE
+	};
 public:
 	NativeFunction(const char* params[], int len, const nativeFunc& callback, Environment* env);
+	NativeFunction(int len, const fastNativeFunc& callback, Environment* env, ArgMode mode = ArgMode::VALUE);
 	virtual ~NativeFunction();
+
+	//ǷʹðλôεĿٵ
+	bool isFast() const { return _fastCallback != nullptr; }
+	//׸Ĵ뷽ʽ
+	ArgMode getArgMode() const { return _mode; }
+	//ٵãargsgetParamSize()ֵ
+	void call(Value* args, Value* ret) const { _fastCallback(args, _paramNum, ret); }
 public:
 	//ȡ
 	virtual unsigned int getParamSize() const;
@@ -30,6 +51,8 @@ private:
 	std::vector<std::string> _parameters;
 	int _paramNum;
 	nativeFunc _callback;
+	fastNativeFunc _fastCallback;
+	ArgMode _mode;
 };
 NS_STONE_END
 #endif
@@ -1,4 +1,5 @@
 #include "NestedEnv.h"
+#include "Cell.h"
 
 NS_STONE_BEGIN
 
@@ -8,6 +9,7 @@ NestedEnv::NestedEnv()
 }
 
 NestedEnv::NestedEnv(Environment* env)
+	:_outer(nullptr)
 {
 	if (env != nullptr)
 	{
@@ -23,6 +25,10 @@ NestedEnv::~NestedEnv()
 
 	//
 	_values.clear();
+
+	for (auto it = _cells.begin(); it != _cells.end(); it++)
+		it->second->release();
+	_cells.clear();
 }
 
 void NestedEnv::setOuter(Environment* env)
@@ -35,19 +41,71 @@ void NestedEnv::setOuter(Environment* env)
 	_outer = env;
 }
 
+void NestedEnv::clear()
+{
+	//Ƴͷţʱٷʱ
+	std::unordered_map<std::string, Value> values;
+	values.swap(_values);
+	values.clear();
+
+	std::unordered_map<std::string, Cell*> cells;
+	cells.swap(_cells);
+	//հԳйԪеֵҲҪ
+	for (auto it = cells.begin(); it != cells.end(); it++)
+	{
+		it->second->value = Value::Null;
+		it->second->release();
+	}
+}
+
 Environment* NestedEnv::where(const std::string& name)
 {
 	//´ڸñֱӷ
 	if (_values.find(name) != _values.end())
 		return this;
+	else if (!_cells.empty() && _cells.find(name) != _cells.end())
+		return this;
 	else if (_outer == nullptr)
 		return nullptr;
 	else
-		return static_cast<NestedEnv*>(_outer)->where(name);
+		return _outer->where(name);
+}
+
+Environment* NestedEnv::getOuter() const
+{
+	return _outer;
 }
-	
+
+Cell* NestedEnv::getCell(const std::string& name)
+{
+	//ѾǹԪ
+	auto cellIt = _cells.find(name);
+	if (cellIt != _cells.end())
+		return cellIt->second;
+
+	auto it = _values.find(name);
+	if (it == _values.end())
+		return nullptr;
+	//ѱ빲Ԫ
+	Cell* cell = new Cell(it->second);
+	_values.erase(it);
+	_cells.emplace(name, cell);
+
+	return cell;
+}
+
 void NestedEnv::putNew(const std::string& name, const Value& value)
 {
+	//ñѱհ
+	if (!_cells.empty())
+	{
+		auto cellIt = _cells.find(name);
+		if (cellIt != _cells.end())
+		{
+			cellIt->second->value = value;
+			return;
+		}
+	}
 	auto it = _values.find(name);
 
 	if (it != _values.end())
@@ -66,7 +124,7 @@ void NestedEnv::put(const std::string& name, const Value& value)
 	if (env == nullptr)
 		env = this;
 
-	static_cast<NestedEnv*>(env)->putNew(name, value);
+	env->putNew(name, value);
 }
 
 const Value* NestedEnv::get(const std::string& name) const
@@ -79,8 +137,15 @@ const Value* NestedEnv::get(const std::string& name) const
 	{
 		return &(it->second);
 	}
+	//ڹԪ
+	if (!_cells.empty())
+	{
+		auto cellIt = _cells.find(name);
+		if (cellIt != _cells.end())
+			return &(cellIt->second->value);
+	}
 	//ڸñи
-	else if (_outer != nullptr)
+	if (_outer != nullptr)
 	{
 		return _outer->get(name);
 	}
@@ -97,8 +162,15 @@ Value* NestedEnv::get(const std::string& name)
 	{
 		return &(it->second);
 	}
+	//ڹԪ
+	if (!_cells.empty())
+	{
+		auto cellIt = _cells.find(name);
+		if (cellIt != _cells.end())
+			return &(cellIt->second->value);
+	}
 	//ڸñи
-	else if (_outer != nullptr)
+	if (_outer != nullptr)
 	{
 		return _outer->get(name);
 	}
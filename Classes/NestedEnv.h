@@ -15,9 +15,14 @@ public:
 	virtual ~NestedEnv();
 
 	void setOuter(Environment* env);
+	//ձıڴƺͻ֮ѭ
+	void clear();
 	
 	//ҰñӦĻظû
-	Environment* where(const std::string& name);
+	virtual Environment* where(const std::string& name);
+	virtual Environment* getOuter() const;
+	//ѱתΪԪ֮󱾻ͱհñ
+	virtual Cell* getCell(const std::string& name);
 
 	//ֱڱ/±
 	virtual void putNew(const std::string& name, const Value& value);
@@ -26,6 +31,8 @@ public:
 	virtual Value* get(const std::string& name);
 private:
 	std::unordered_map<std::string, Value> _values;
+	//հһᱻ޸ĵı
+	std::unordered_map<std::string, Cell*> _cells;
 	Environment* _outer;
 };
 NS_STONE_END
@@ -1,17 +1,23 @@
 #include "NumberLiteral.h"
 #include "Token.h"
 #include "Visitor.h"
+#include "BigInt.h"
 
 NS_STONE_BEGIN
 
 NumberLiteral::NumberLiteral(Token* token)
 	:ASTLeaf(token)
 {
-}
-
-int NumberLiteral::getValue() const
-{
-	return getToken()->asInt();
+	if (token->isFloat())
+		_value = token->asDouble();
+	else if (token->isBig())
+	{
+		BigInt* number = BigInt::create(token->asString());
+		_value = Value(number);
+		number->release();
+	}
+	else
+		_value = token->asLong();
 }
 
 void NumberLiteral::accept(Visitor* v, Environment* env)
@@ -2,6 +2,7 @@
 #define __Stone_NumberLiteral_H__
 
 #include "ASTLeaf.h"
+#include "Value.h"
 NS_STONE_BEGIN
 
 class Token;
@@ -12,10 +13,13 @@ class NumberLiteral : public ASTLeaf
 {
 public:
 	NumberLiteral(Token* token);
-	//ȡֵ
-	int getValue() const;
+	//ȡֵ߸
+	const Value& getValue() const { return _value; }
 public:
 	virtual void accept(Visitor* v, Environment* env);
+private:
+	//ʱתãֵʱֱӸ
+	Value _value;
 };
 NS_STONE_END
 #endif
\ No newline at end of file
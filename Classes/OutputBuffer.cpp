@@ -0,0 +1,70 @@
+#include <cstdio>
+
+#include "OutputBuffer.h"
+
+NS_STONE_BEGIN
+
+OutputBuffer::OutputBuffer()
+	:OutputBuffer([](const char* data, size_t size) {
+		fwrite(data, 1, size, stdout);
+		fflush(stdout);
+	})
+{
+}
+
+OutputBuffer::OutputBuffer(const Sink& sink)
+	:_sink(sink)
+	,_threshold(OUTPUT_BUFFER_THRESHOLD)
+{
+}
+
+OutputBuffer::~OutputBuffer()
+{
+	this->flush();
+}
+
+void OutputBuffer::setThreshold(size_t threshold)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_threshold = threshold;
+	if (_buffer.size() >= _threshold)
+		this->flushLocked();
+}
+
+void OutputBuffer::write(const char* data, size_t size)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	//Ϊʱϴֱд
+	if (_buffer.empty() && size >= _threshold)
+	{
+		_sink(data, size);
+		return;
+	}
+	_buffer.append(data, size);
+	if (_buffer.size() >= _threshold)
+		this->flushLocked();
+}
+
+void OutputBuffer::writeLine(const char* data, size_t size)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_buffer.append(data, size);
+	_buffer += '\n';
+	if (_buffer.size() >= _threshold)
+		this->flushLocked();
+}
+
+void OutputBuffer::flush()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	this->flushLocked();
+}
+
+void OutputBuffer::flushLocked()
+{
+	if (_buffer.empty())
+		return;
+	_sink(_buffer.data(), _buffer.size());
+	_buffer.clear();
+}
+NS_STONE_END
\ No newline at end of file
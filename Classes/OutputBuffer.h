@@ -0,0 +1,51 @@
+#ifndef __Stone_OutputBuffer_H__
+#define __Stone_OutputBuffer_H__
+
+#include <string>
+#include <mutex>
+#include <functional>
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+//ĬϵĻСд
+#define OUTPUT_BUFFER_THRESHOLD (64 * 1024)
+
+/*
+	壬printȱغдÿһϵͳ
+	ݳֵflushű¼ѭȴʱд
+	pmapȲҲд룬˼
+*/
+class OutputBuffer
+{
+public:
+	//дݵĿ
+	typedef std::function<void(const char* data, size_t size)> Sink;
+public:
+	//д׼
+	OutputBuffer();
+	explicit OutputBuffer(const Sink& sink);
+	virtual ~OutputBuffer();
+
+	//ݴﵽthresholdʱдΪ0ʱÿд붼д
+	void setThreshold(size_t threshold);
+	size_t getThreshold() const { return _threshold; }
+
+	void write(const char* data, size_t size);
+	void write(const std::string& text) { this->write(text.data(), text.size()); }
+	//дһУ뻻зһд룬̵߳ύ
+	void writeLine(const char* data, size_t size);
+	//де
+	void flush();
+private:
+	//ʱҪס_mutex
+	void flushLocked();
+private:
+	Sink _sink;
+	std::string _buffer;
+	size_t _threshold;
+	std::mutex _mutex;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "OutputNatives.h"
+#include "Environment.h"
+#include "OutputBuffer.h"
+
+NS_STONE_BEGIN
+
+void registerOutputNatives(Environment* env, OutputBuffer* output)
+{
+	//print(v) һУv
+	env->bindNative("print", [output](const Value& value) -> const Value& {
+		const char* data = nullptr;
+		size_t size = 0;
+		//ַ
+		if (value.getChars(data, size))
+			output->writeLine(data, size);
+		else
+		{
+			std::string text = value.asString();
+			output->writeLine(text.data(), text.size());
+		}
+		return value;
+	});
+	//flush() д
+	env->bindNative("flush", [output]() {
+		output->flush();
+	});
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,18 @@
+#ifndef __Stone_OutputNatives_H__
+#define __Stone_OutputNatives_H__
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class Environment;
+class OutputBuffer;
+
+/*
+	ıغ print flush
+	print(v)vַʽͻд岢vflush()д
+*/
+void registerOutputNatives(Environment* env, OutputBuffer* output);
+
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <algorithm>
+
+#include "PackedArray.h"
+
+NS_STONE_BEGIN
+
+PackedArray::PackedArray()
+	:_kind(Kind::LONG)
+	,_size(0)
+	,_maxAbs(0)
+{
+}
+
+void PackedArray::pack(const Value* values, unsigned int size)
+{
+	_kind = Kind::LONG;
+	_size = size;
+	_maxAbs = 0;
+	_longs.resize(size);
+
+	for (unsigned int i = 0; i < size; i++)
+	{
+		if (values[i].getType() != Value::Type::INTEGER)
+		{
+			_kind = isFloating(values[i]) ? Kind::DOUBLE : Kind::OTHER;
+			break;
+		}
+		int64_t value = values[i].asLong();
+		uint64_t abs = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+
+		_longs[i] = value;
+		_maxAbs = std::max(_maxAbs, abs);
+	}
+	if (_kind != Kind::DOUBLE)
+		return;
+	//иȫΪdouble
+	_doubles.resize(size);
+	for (unsigned int i = 0; i < size; i++)
+	{
+		if (!values[i].isNumber() || values[i].getType() == Value::Type::BIG_INTEGER)
+		{
+			_kind = Kind::OTHER;
+			return;
+		}
+		_doubles[i] = values[i].asDouble();
+	}
+}
+
+void PackedArray::promote()
+{
+	if (_kind != Kind::LONG)
+		return;
+	_doubles.assign(_longs.begin(), _longs.begin() + _size);
+	_kind = Kind::DOUBLE;
+}
+
+void PackedArray::broadcast(unsigned int size)
+{
+	if (_size != 1 || size == 1)
+		return;
+	if (_kind == Kind::LONG)
+		_longs.assign(size, _longs[0]);
+	else if (_kind == Kind::DOUBLE)
+		_doubles.assign(size, _doubles[0]);
+	_size = size;
+}
+
+Value PackedArray::toValue() const
+{
+	Value ret = Value(ValueVector());
+	auto& list = ret.asValueVector();
+
+	list.reserve(_size);
+	for (unsigned int i = 0; i < _size; i++)
+	{
+		if (_kind == Kind::LONG)
+			list.push_back(Value(_longs[i]));
+		else
+			list.push_back(Value(_doubles[i]));
+	}
+	return ret;
+}
+
+bool PackedArray::fitsLong(uint64_t a, uint64_t b, uint64_t count)
+{
+	const uint64_t limit = (uint64_t)INT64_MAX;
+
+	if (a == 0 || b == 0 || count == 0)
+		return true;
+	return a <= limit / b && a * b <= limit / count;
+}
+
+bool PackedArray::isFloating(const Value& value)
+{
+	return value.isNumber() && !value.isInteger();
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef __Stone_PackedArray_H__
+#define __Stone_PackedArray_H__
+
+#include <vector>
+#include <cstdint>
+
+#include "Value.h"
+
+NS_STONE_BEGIN
+
+/*
+	ԪظƵĻУVectorKernels
+	ȫΪʱlongsиʱΪdoubledoubles
+	д߷ֵʱΪOTHERֻԪؼ
+*/
+class PackedArray
+{
+public:
+	enum class Kind
+	{
+		LONG,
+		DOUBLE,
+		OTHER
+	};
+public:
+	PackedArray();
+
+	void pack(const Value* values, unsigned int size);
+	//Ϊdouble
+	void promote();
+	//ֻһԪʱظΪsizeں
+	void broadcast(unsigned int size);
+	//תΪ
+	Value toValue() const;
+
+	Kind getKind() const { return _kind; }
+	unsigned int size() const { return _size; }
+	int64_t* getLongs() { return _longs.data(); }
+	double* getDoubles() { return _doubles.data(); }
+	//ֵֵжǷ
+	uint64_t getMaxAbs() const { return _maxAbs; }
+public:
+	//a * b * count Ƿ񲻻ᳬint64
+	static bool fitsLong(uint64_t a, uint64_t b, uint64_t count);
+	//ǷΪ
+	static bool isFloating(const Value& value);
+private:
+	Kind _kind;
+	unsigned int _size;
+	std::vector<int64_t> _longs;
+	std::vector<double> _doubles;
+	uint64_t _maxAbs;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
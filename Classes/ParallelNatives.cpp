@@ -0,0 +1,103 @@
+#include <vector>
+
+#include "ParallelNatives.h"
+#include "Environment.h"
+#include "StoneException.h"
+#include "EvalVisitor.h"
+#include "Function.h"
+#include "TaskPool.h"
+
+NS_STONE_BEGIN
+
+//ȡԪغΪصĺ
+static void getArguments(Value* args, const Value*& data, unsigned int& size, Function*& function)
+{
+	if (!args[0].getElements(data, size))
+		throw StoneException("bad array");
+	if (args[1].getType() != Value::Type::FUNCTION)
+		throw StoneException("bad function");
+	function = args[1].asFunction();
+}
+
+//pmap(a, f) ÿԪصfؽɵ
+static void pmap(Value* args, unsigned int argc, Value* ret)
+{
+	const Value* data = nullptr;
+	unsigned int size = 0;
+	Function* function = nullptr;
+	getArguments(args, data, size, function);
+
+	Value result = Value(ValueVector());
+	auto& list = result.asValueVector();
+	list.resize(size);
+	TaskPool::getInstance()->parallelFor(size, [&](EvalVisitor* visitor, unsigned int begin, unsigned int end) {
+		for (unsigned int i = begin; i < end; i++)
+			list[i] = visitor->invoke(function, &data[i], 1);
+	});
+	*ret = std::move(result);
+}
+
+//pfilter(a, f) fԪأ˳򲻱
+static void pfilter(Value* args, unsigned int argc, Value* ret)
+{
+	const Value* data = nullptr;
+	unsigned int size = 0;
+	Function* function = nullptr;
+	getArguments(args, data, size, function);
+
+	std::vector<char> keep(size);
+	TaskPool::getInstance()->parallelFor(size, [&](EvalVisitor* visitor, unsigned int begin, unsigned int end) {
+		for (unsigned int i = begin; i < end; i++)
+			keep[i] = visitor->invoke(function, &data[i], 1).asBool();
+	});
+	Value result = Value(ValueVector());
+	auto& list = result.asValueVector();
+	for (unsigned int i = 0; i < size; i++)
+	{
+		if (keep[i])
+			list.push_back(data[i]);
+	}
+	*ret = std::move(result);
+}
+
+//preduce(a, f, init) f(acc, x)Լ鷵init
+static void preduce(Value* args, unsigned int argc, Value* ret)
+{
+	const Value* data = nullptr;
+	unsigned int size = 0;
+	Function* function = nullptr;
+	getArguments(args, data, size, function);
+
+	auto pool = TaskPool::getInstance();
+	//ÿĽʼλñ棬ϲʱ˳
+	std::vector<Value> partials(size);
+	std::vector<char> used(size);
+	pool->parallelFor(size, [&](EvalVisitor* visitor, unsigned int begin, unsigned int end) {
+		Value pair[2] = { data[begin], Value::Null };
+		for (unsigned int i = begin + 1; i < end; i++)
+		{
+			pair[1] = data[i];
+			pair[0] = visitor->invoke(function, pair, 2);
+		}
+		partials[begin] = std::move(pair[0]);
+		used[begin] = true;
+	});
+	EvalVisitor* visitor = pool->getVisitor();
+	Value pair[2] = { args[2], Value::Null };
+	for (unsigned int i = 0; i < size; i++)
+	{
+		if (!used[i])
+			continue;
+		pair[1] = std::move(partials[i]);
+		pair[0] = visitor->invoke(function, pair, 2);
+	}
+	*ret = std::move(pair[0]);
+}
+
+void registerParallelNatives(Environment* env)
+{
+	env->putNative("pmap", pmap, 2);
+	env->putNative("pfilter", pfilter, 2);
+	env->putNative("preduce", preduce, 3);
+}
+NS_STONE_END
\ No newline at end of file
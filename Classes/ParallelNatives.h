@@ -0,0 +1,19 @@
+#ifndef __Stone_ParallelNatives_H__
+#define __Stone_ParallelNatives_H__
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class Environment;
+
+/*
+	дıغ pmap pfilter preduce
+	ֿ󽻸TaskPoolĸ̣߳ÿ߳Լִú
+	ֻ޸Լľֲıȫֱֻ
+	preduceÿڹԼٰ˳ϲҪ
+*/
+void registerParallelNatives(Environment* env);
+
+NS_STONE_END
+#endif
\ No newline at end of file
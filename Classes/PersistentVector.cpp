@@ -0,0 +1,171 @@
+#include "PersistentVector.h"
+
+//ÿڵķ֧Ϊ2^BITS
+#define BITS 5
+#define WIDTH (1 << BITS)
+#define MASK (WIDTH - 1)
+
+NS_STONE_BEGIN
+
+/*
+	Ľڵ㣬Ҷӽڵ㱣Ԫأڵ㱣ӽڵ
+*/
+class PersistentVector::Node : public Object
+{
+public:
+	Node() {}
+	//ƽڵ㣬ӽڵ㹲
+	Node(const Node& node)
+		:values(node.values)
+		,children(node.children)
+	{
+		for (auto child : children)
+			child->retain();
+	}
+	virtual ~Node()
+	{
+		for (auto child : children)
+			child->release();
+	}
+public:
+	std::vector<Value> values;
+	std::vector<Node*> children;
+};
+
+PersistentVector::PersistentVector(Node* root, unsigned int shift, unsigned int size)
+	:_root(root)
+	,_shift(shift)
+	,_size(size)
+{
+}
+
+PersistentVector::~PersistentVector()
+{
+	_root->release();
+}
+
+PersistentVector* PersistentVector::create(const ValueVector& list)
+{
+	return PersistentVector::create(list.data(), list.size());
+}
+
+PersistentVector* PersistentVector::create(const Value* data, unsigned int size)
+{
+	std::vector<Node*> nodes;
+	unsigned int shift = 0;
+	//Ҷӽڵ
+	for (unsigned int i = 0; i < size; i += WIDTH)
+	{
+		Node* leaf = new Node();
+		leaf->values.assign(data + i, data + std::min<unsigned int>(i + WIDTH, size));
+		nodes.push_back(leaf);
+	}
+	if (nodes.empty())
+		nodes.push_back(new Node());
+	//ÿWIDTHڵϲΪһ㣬ֱֻʣڵ
+	while (nodes.size() > 1)
+	{
+		std::vector<Node*> parents;
+		for (unsigned int i = 0; i < nodes.size(); i += WIDTH)
+		{
+			Node* parent = new Node();
+			parent->children.assign(nodes.begin() + i, nodes.begin() + std::min<size_t>(i + WIDTH, nodes.size()));
+			parents.push_back(parent);
+		}
+		nodes.swap(parents);
+		shift += BITS;
+	}
+	return new PersistentVector(nodes.front(), shift, size);
+}
+
+const Value& PersistentVector::at(unsigned int index) const
+{
+	Node* node = _root;
+
+	for (unsigned int level = _shift; level > 0; level -= BITS)
+		node = node->children[(index >> level) & MASK];
+	return node->values[index & MASK];
+}
+
+PersistentVector* PersistentVector::assoc(unsigned int index, const Value& value) const
+{
+	return new PersistentVector(this->assocNode(_root, _shift, index, value), _shift, _size);
+}
+
+PersistentVector* PersistentVector::push(const Value& value) const
+{
+	//ڵһ
+	if (_size == (1u << (_shift + BITS)))
+	{
+		Node* root = new Node();
+		_root->retain();
+		root->children.push_back(_root);
+		root->children.push_back(this->pushNode(nullptr, _shift, value));
+		return new PersistentVector(root, _shift + BITS, _size + 1);
+	}
+	return new PersistentVector(this->pushNode(_root, _shift, value), _shift, _size + 1);
+}
+
+ValueVector PersistentVector::toVector() const
+{
+	ValueVector list;
+
+	list.reserve(_size);
+	for (unsigned int i = 0; i < _size; i++)
+		list.push_back(this->at(i));
+	return list;
+}
+
+bool PersistentVector::equals(const PersistentVector* vector) const
+{
+	if (this == vector)
+		return true;
+	if (_size != vector->_size)
+		return false;
+
+	for (unsigned int i = 0; i < _size; i++)
+	{
+		if (!(this->at(i) == vector->at(i)))
+			return false;
+	}
+	return true;
+}
+
+PersistentVector::Node* PersistentVector::assocNode(Node* node, unsigned int shift, unsigned int index, const Value& value) const
+{
+	Node* copy = new Node(*node);
+
+	if (shift == 0)
+		copy->values[index & MASK] = value;
+	else
+	{
+		unsigned int i = (index >> shift) & MASK;
+		Node* child = this->assocNode(node->children[i], shift - BITS, index, value);
+		copy->children[i]->release();
+		copy->children[i] = child;
+	}
+	return copy;
+}
+
+PersistentVector::Node* PersistentVector::pushNode(Node* node, unsigned int shift, const Value& value) const
+{
+	//µ·
+	Node* copy = node != nullptr ? new Node(*node) : new Node();
+
+	if (shift == 0)
+		copy->values.push_back(value);
+	else
+	{
+		unsigned int i = (_size >> shift) & MASK;
+		if (i < copy->children.size())
+		{
+			Node* child = this->pushNode(copy->children[i], shift - BITS, value);
+			copy->children[i]->release();
+			copy->children[i] = child;
+		}
+		else
+			copy->children.push_back(this->pushNode(nullptr, shift - BITS, value));
+	}
+	return copy;
+}
+NS_STONE_END
\ No newline at end of file
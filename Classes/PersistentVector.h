@@ -0,0 +1,46 @@
+#ifndef __Stone_PersistentVector_H__
+#define __Stone_PersistentVector_H__
+
+#include <vector>
+
+#include "STObject.h"
+#include "Value.h"
+
+NS_STONE_BEGIN
+
+/*
+	ɱĳ־û飬32Ԫأ޸ʱֻƴӸҶӵ·
+	ڵڸ汾֮乲һ汾ֻҪü
+*/
+class PersistentVector : public Object
+{
+public:
+	//鴴صĶüΪ1
+	static PersistentVector* create(const ValueVector& list);
+	//ŵsizeԪشصĶüΪ1
+	static PersistentVector* create(const Value* data, unsigned int size);
+	virtual ~PersistentVector();
+
+	unsigned int size() const { return _size; }
+	//ȡԪأindexСsize()
+	const Value& at(unsigned int index) const;
+	//޸Ԫأµİ汾üΪ1
+	PersistentVector* assoc(unsigned int index, const Value& value) const;
+	//ĩβԪأµİ汾üΪ1
+	PersistentVector* push(const Value& value) const;
+	//תΪͨ
+	ValueVector toVector() const;
+	bool equals(const PersistentVector* vector) const;
+private:
+	class Node;
+	PersistentVector(Node* root, unsigned int shift, unsigned int size);
+	Node* assocNode(Node* node, unsigned int shift, unsigned int index, const Value& value) const;
+	Node* pushNode(Node* node, unsigned int shift, const Value& value) const;
+private:
+	Node* _root;
+	//ڵĲ * 5
+	unsigned int _shift;
+	unsigned int _size;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
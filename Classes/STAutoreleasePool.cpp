@@ -3,16 +3,27 @@
 
 NS_STONE_BEGIN
 
-AutoreleasePool* AutoreleasePool::_pInstance = nullptr;
+thread_local AutoreleasePool* AutoreleasePool::_pInstance = nullptr;
+thread_local AutoreleasePool* AutoreleasePool::_pCurrent = nullptr;
 
 AutoreleasePool* AutoreleasePool::getInstance()
 {
+	if (_pCurrent != nullptr)
+		return _pCurrent;
 	if (_pInstance == nullptr)
 		_pInstance = new AutoreleasePool();
 
 	return _pInstance;
 }
 
+AutoreleasePool* AutoreleasePool::setInstance(AutoreleasePool* pool)
+{
+	AutoreleasePool* previous = _pCurrent;
+	_pCurrent = pool;
+
+	return previous;
+}
+
 void AutoreleasePool::purge()
 {
 	if (_pInstance != nullptr)
@@ -50,6 +61,8 @@ void AutoreleasePool::removeObject(Object* pObject)
 
 void AutoreleasePool::clear()
 {
+	//ͷųǰȫ㣬˳ִ߳Ƴٵͷ
+	Object::processDeferred();
 	for (auto it = _managedObjects.begin(); it != _managedObjects.end();)
 	{
 		auto object = *it;
@@ -8,14 +8,21 @@ NS_STONE_BEGIN
 
 class Object;
 
+/*
+	Զͷųأÿ߳һĬϵͷų
+	ʱԼͷųΪǰ߳ʹõͷų
+*/
 class AutoreleasePool
 {
 public:
+	//ǰ߳ʹõͷų
 	static AutoreleasePool* getInstance();
+	//õǰ߳ʹõͷųأnullptrʾʹĬϵͷųأ֮ǰõ
+	static AutoreleasePool* setInstance(AutoreleasePool* pool);
+	//ͷŵǰ߳Ĭϵͷųأ߳̽ǰҪ
 	static void purge();
-protected:
-	AutoreleasePool();
 public:
+	AutoreleasePool();
 	virtual ~AutoreleasePool();
 	//insert dirfferent
 	void addObject(Object* pObject);
@@ -24,7 +31,8 @@ public:
 	void clear();
 private:
 	std::vector<Object*> _managedObjects;
-	static AutoreleasePool* _pInstance;
+	static thread_local AutoreleasePool* _pInstance;
+	static thread_local AutoreleasePool* _pCurrent;
 };
 NS_STONE_END
 #endif
\ No newline at end of file
@@ -1,9 +1,87 @@
 #include "STObject.h"
 #include "STAutoreleasePool.h"
 
+#if STONE_REFCOUNT_POLICY == STONE_REFCOUNT_BIASED
+#include <mutex>
+#include <vector>
+#endif
+
 NS_STONE_BEGIN
+#if STONE_REFCOUNT_POLICY == STONE_REFCOUNT_BIASED
+//еĺϲ־
+#define MERGED_FLAG (INT64_C(1) << 62)
+
+/*
+	̵߳ƫ¼
+	߳ͷʱΪ0ֱӼ٣ͷŷߵĶУ
+	߳ڰȫ(Զͷųʱ)ִ
+	߳̽¼Ȼֱ֮߳Ӻϲ̴߳Ķ
+*/
+struct RefcountOwner
+{
+	std::mutex mutex;
+	std::vector<Object*> deferred;
+	bool alive;
+
+	RefcountOwner() :alive(true) {}
+	//ִƳٵͷֱΪգexitingΪtrueʱ߳ѽ
+	void drain(bool exiting)
+	{
+		while (true)
+		{
+			std::vector<Object*> objects;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (deferred.empty())
+				{
+					if (exiting)
+						alive = false;
+					return;
+				}
+				objects.swap(deferred);
+			}
+			//ͷʱпƳٵ߳
+			for (auto object : objects)
+				object->release();
+		}
+	}
+};
+
+//ǰ̵߳ļ¼߳̽ΪnullptrʱĶһʼѺϲ
+static thread_local RefcountOwner* s_owner = nullptr;
+static thread_local bool s_exited = false;
+
+//߳̽ʱִʣƳͷ
+struct RefcountOwnerGuard
+{
+	~RefcountOwnerGuard()
+	{
+		s_owner->drain(true);
+		s_owner = nullptr;
+		s_exited = true;
+	}
+};
+
+static RefcountOwner* getCurrentOwner()
+{
+	if (s_owner == nullptr && !s_exited)
+	{
+		static thread_local RefcountOwnerGuard guard;
+		s_owner = new RefcountOwner();
+	}
+	return s_owner;
+}
+#endif
+
 Object::Object()
+#if STONE_REFCOUNT_POLICY == STONE_REFCOUNT_BIASED
+	:_owner(getCurrentOwner())
+	,_biasedCount(_owner != nullptr ? 1 : 0)
+	,_merged(_owner == nullptr)
+	,_sharedCount(_owner != nullptr ? 0 : MERGED_FLAG + 1)
+#else
 	:_referenceCount(1)
+#endif
 	,_managed(false)
 {
 }
@@ -16,6 +94,7 @@ Object::~Object()
 		AutoreleasePool::getInstance()->removeObject(this);
 	}
 }
+#if STONE_REFCOUNT_POLICY == STONE_REFCOUNT_NONATOMIC
 //
 void Object::retain()
 {
@@ -30,6 +109,127 @@ void Object::release()
 		delete this;
 }
 
+unsigned int Object::getReferenceCount() const
+{
+	return _referenceCount;
+}
+
+void Object::processDeferred()
+{
+}
+#elif STONE_REFCOUNT_POLICY == STONE_REFCOUNT_ATOMIC
+//
+void Object::retain()
+{
+	//òҪ
+	_referenceCount.fetch_add(1, std::memory_order_relaxed);
+}
+//ͷ
+void Object::release()
+{
+	//һͷҪ֮߳ǰ޸
+	if (_referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		delete this;
+}
+
+unsigned int Object::getReferenceCount() const
+{
+	return _referenceCount.load(std::memory_order_relaxed);
+}
+
+void Object::processDeferred()
+{
+}
+#else
+//
+void Object::retain()
+{
+	if (this->isOwner() && !_merged)
+		_biasedCount++;
+	else
+		_sharedCount.fetch_add(1, std::memory_order_relaxed);
+}
+//ͷ
+void Object::release()
+{
+	if (this->isOwner())
+	{
+		if (_merged)
+		{
+			this->releaseShared();
+			return;
+		}
+		if (--_biasedCount > 0)
+			return;
+		//߲ãϲͷŵ߳ɾ
+		_merged = true;
+		if (_sharedCount.fetch_add(MERGED_FLAG, std::memory_order_acq_rel) == 0)
+			delete this;
+		return;
+	}
+	int64_t count = _sharedCount.load(std::memory_order_relaxed);
+	while ((count & MERGED_FLAG) == 0)
+	{
+		//δϲʱܼ0£ִ߳
+		if (count == 0)
+		{
+			{
+				std::lock_guard<std::mutex> lock(_owner->mutex);
+				if (_owner->alive)
+				{
+					_owner->deferred.push_back(this);
+					return;
+				}
+				//߳ѽֱӺϲ
+				this->merge();
+			}
+			break;
+		}
+		if (_sharedCount.compare_exchange_weak(count, count - 1, std::memory_order_release, std::memory_order_relaxed))
+			return;
+	}
+	this->releaseShared();
+}
+
+unsigned int Object::getReferenceCount() const
+{
+	int64_t count = _sharedCount.load(std::memory_order_relaxed);
+
+	if (count & MERGED_FLAG)
+		return (unsigned int)(count - MERGED_FLAG);
+	if (this->isOwner())
+		return _biasedCount + (unsigned int)count;
+	//޷֪ߵصֵᱻΨһ
+	return (unsigned int)count + 2;
+}
+
+void Object::processDeferred()
+{
+	if (s_owner != nullptr)
+		s_owner->drain(false);
+}
+
+bool Object::isOwner() const
+{
+	return _owner != nullptr && _owner == s_owner;
+}
+
+void Object::merge()
+{
+	if (_merged)
+		return;
+	_merged = true;
+	_sharedCount.fetch_add(MERGED_FLAG + (int64_t)_biasedCount, std::memory_order_acq_rel);
+	_biasedCount = 0;
+}
+
+void Object::releaseShared()
+{
+	if (_sharedCount.fetch_sub(1, std::memory_order_acq_rel) == MERGED_FLAG + 1)
+		delete this;
+}
+#endif
+
 Object* Object::autorelease()
 {
 	//ظ
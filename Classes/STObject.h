@@ -1,18 +1,36 @@
 #ifndef __Stone_Object_H__
 #define __Stone_Object_H__
 
+#include <atomic>
+#include <cstdint>
+
 #include "StoneMarcos.h"
 
 NS_STONE_BEGIN
 
 class AutoreleasePool;
+struct RefcountOwner;
 
 //Ļ
 class Object
 {
 protected:
+#if STONE_REFCOUNT_POLICY == STONE_REFCOUNT_NONATOMIC
 	//ü
 	unsigned int _referenceCount;
+#elif STONE_REFCOUNT_POLICY == STONE_REFCOUNT_ATOMIC
+	//üڶ̼߳乲ʹԭӲ
+	std::atomic<unsigned int> _referenceCount;
+#else
+	//̣߳ΪnullptrʾһʼѺϲ
+	RefcountOwner* _owner;
+	//̵̷ֻ߳߳
+	unsigned int _biasedCount;
+	//ߵΪ0ϲУ̶֮߳ʹù
+	bool _merged;
+	//̵߳λΪϲ־δϲʱ0
+	std::atomic<int64_t> _sharedCount;
+#endif
 	//Ƿڴ
 	bool _managed;
 public:
@@ -25,12 +43,23 @@ public:
 	void release();
 	//Զͷ
 	Object*autorelease();
-	//
-	unsigned int getReferenceCount() const { return _referenceCount; }
+	//ƫ߳ںϲǰֻܵõһС2Ĺֵ
+	unsigned int getReferenceCount() const;
 	//Ƿ񽻸ͷų
 	bool isManaged() const { return _managed; }
+	//ִ߳Ƴٸǰ̵߳ͷţƫĲԲҪ
+	static void processDeferred();
 	//Ԫ
 	friend class AutoreleasePool;
+#if STONE_REFCOUNT_POLICY == STONE_REFCOUNT_BIASED
+	friend struct RefcountOwner;
+private:
+	bool isOwner() const;
+	//ϲУҪߵ̵߳
+	void merge();
+	//Ѻϲʱٹ
+	void releaseShared();
+#endif
 };
 NS_STONE_END
 #endif
\ No newline at end of file
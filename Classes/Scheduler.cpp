@@ -0,0 +1,139 @@
+#include <deque>
+#include <thread>
+
+#include "Scheduler.h"
+#include "Fiber.h"
+#include "TaskGroup.h"
+#include "STAutoreleasePool.h"
+
+NS_STONE_BEGIN
+
+struct Scheduler::Worker
+{
+	std::deque<Fiber*> fibers;
+	std::mutex mutex;
+	std::thread thread;
+	unsigned int index;
+};
+
+Scheduler* Scheduler::_pInstance = nullptr;
+std::mutex Scheduler::_instanceMutex;
+thread_local Scheduler::Worker* Scheduler::_current = nullptr;
+
+Scheduler* Scheduler::getInstance()
+{
+	std::lock_guard<std::mutex> lock(_instanceMutex);
+	if (_pInstance == nullptr)
+	{
+		//ͬһֻ߳Ӱ첻֮ͬĲ
+		unsigned int count = std::thread::hardware_concurrency();
+		_pInstance = new Scheduler(count > 0 ? count : 1);
+	}
+	return _pInstance;
+}
+
+void Scheduler::purge()
+{
+	std::lock_guard<std::mutex> lock(_instanceMutex);
+	if (_pInstance != nullptr)
+	{
+		delete _pInstance;
+		_pInstance = nullptr;
+	}
+}
+
+Scheduler::Scheduler(unsigned int threadCount)
+	:_next(0)
+	,_pending(0)
+	,_stop(false)
+{
+	for (unsigned int i = 0; i < threadCount; i++)
+	{
+		Worker* worker = new Worker();
+		worker->index = i;
+		_workers.push_back(worker);
+	}
+	for (auto worker : _workers)
+		worker->thread = std::thread(&Scheduler::run, this, worker);
+}
+
+Scheduler::~Scheduler()
+{
+	//ѵȴԼΪ
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_condition.notify_all();
+
+	for (auto worker : _workers)
+	{
+		worker->thread.join();
+		delete worker;
+	}
+	_workers.clear();
+}
+
+void Scheduler::schedule(Fiber* fiber)
+{
+	Worker* worker = _current != nullptr ? _current : _workers[_next.fetch_add(1) % _workers.size()];
+	{
+		std::lock_guard<std::mutex> lock(worker->mutex);
+		worker->fibers.push_back(fiber);
+	}
+	_pending.fetch_add(1);
+	//֪ͨȴ̼֪߳ͨ
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+	}
+	_condition.notify_one();
+}
+
+void Scheduler::run(Worker* worker)
+{
+	_current = worker;
+
+	while (true)
+	{
+		Fiber* fiber = this->pop(worker);
+		if (fiber != nullptr)
+		{
+			_pending.fetch_sub(1);
+			fiber->getGroup()->resume(fiber);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(_mutex);
+		_condition.wait(lock, [this]() { return _stop || _pending.load() > 0; });
+		if (_stop)
+			break;
+	}
+	AutoreleasePool::purge();
+}
+
+Fiber* Scheduler::pop(Worker* self)
+{
+	Fiber* fiber = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(self->mutex);
+		if (!self->fibers.empty())
+		{
+			fiber = self->fibers.front();
+			self->fibers.pop_front();
+			return fiber;
+		}
+	}
+	for (unsigned int i = 1; i < _workers.size(); i++)
+	{
+		Worker* victim = _workers[(self->index + i) % _workers.size()];
+
+		std::lock_guard<std::mutex> lock(victim->mutex);
+		if (!victim->fibers.empty())
+		{
+			fiber = victim->fibers.back();
+			victim->fibers.pop_back();
+			return fiber;
+		}
+	}
+	return nullptr;
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef __Stone_Scheduler_H__
+#define __Stone_Scheduler_H__
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class Fiber;
+
+/*
+	M:N̶߳н
+	ÿ߳ԼĿжУΪʱ̵߳Ķȡ
+	ԼĶаȽȳִУóŵ󣬱
+	߳ǰȡóʱͷ
+*/
+class Scheduler
+{
+public:
+	static Scheduler* getInstance();
+	static void purge();
+protected:
+	Scheduler(unsigned int threadCount);
+public:
+	virtual ~Scheduler();
+
+	//е񣬵߳еʱԼĶ
+	void schedule(Fiber* fiber);
+	unsigned int getThreadCount() const { return _workers.size(); }
+private:
+	struct Worker;
+	//̵߳ѭ
+	void run(Worker* worker);
+	//ȴԼĶͷȡٴβȡ
+	Fiber* pop(Worker* self);
+private:
+	std::vector<Worker*> _workers;
+	//߳
+	std::atomic<unsigned int> _next;
+	//еڿ̵߳ȴ
+	std::atomic<unsigned int> _pending;
+	bool _stop;
+	std::mutex _mutex;
+	std::condition_variable _condition;
+
+	static Scheduler* _pInstance;
+	static std::mutex _instanceMutex;
+	//ǰ̶߳Ӧĵ̣߳߳Ϊnullptr
+	static thread_local Worker* _current;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -1,22 +1,31 @@
 #include "ScriptFunction.h"
 #include "ParameterList.h"
 #include "BlockStmnt.h"
+#include "FrameLayout.h"
+#include "EvalVisitor.h"
+#include "Generator.h"
 
 NS_STONE_BEGIN
 
-ScriptFunction::ScriptFunction(ParameterList* parameters, BlockStmnt* block, Environment* env)
+ScriptFunction::ScriptFunction(ParameterList* parameters, BlockStmnt* block, Environment* env, FrameLayout* layout, bool generator)
 	:Function(env)
 	,_parameters(parameters)
 	,_body(block)
+	,_layout(layout)
+	,_generator(generator)
 {
 	_parameters->retain();
 	_body->retain();
+	if (_layout != nullptr)
+		_layout->retain();
 }
 
 ScriptFunction::~ScriptFunction()
 {
 	_parameters->release();
 	_body->release();
+	if (_layout != nullptr)
+		_layout->release();
 }
 
 unsigned int ScriptFunction::getParamSize() const
@@ -31,6 +40,20 @@ std::string ScriptFunction::getParamName(unsigned index) const
 
 void ScriptFunction::execute(Visitor* v, Environment* env)
 {
+	//ڵʱִУû
+	if (_generator)
+	{
+		EvalVisitor* visitor = static_cast<EvalVisitor*>(v);
+		Generator* generator = new Generator(this, env, visitor->isConcurrent());
+		visitor->setResult(Value(generator));
+		generator->release();
+		return;
+	}
 	_body->accept(v, env);
 }
+
+FrameLayout* ScriptFunction::getFrameLayout() const
+{
+	return _layout;
+}
 NS_STONE_END
\ No newline at end of file
@@ -8,22 +8,29 @@ NS_STONE_BEGIN
 class ParameterList;
 class BlockStmnt;
 class Environment;
+class FrameLayout;
 
 class ScriptFunction : public Function
 {
 public:
-	ScriptFunction(ParameterList* parameters, BlockStmnt* block, Environment* env);
+	ScriptFunction(ParameterList* parameters, BlockStmnt* block, Environment* env, FrameLayout* layout = nullptr, bool generator = false);
 	virtual ~ScriptFunction();
 public:
 	//ȡ
 	virtual unsigned int getParamSize() const;
 	//ȡ
 	virtual std::string getParamName(unsigned index) const;
-	//ִк
+	//ִкֻ
 	virtual void execute(Visitor* v, Environment* env);
+	virtual FrameLayout* getFrameLayout() const;
+
+	BlockStmnt* getBody() const { return _body; }
+	bool isGenerator() const { return _generator; }
 private:
 	ParameterList* _parameters;
 	BlockStmnt* _body;
+	FrameLayout* _layout;
+	bool _generator;
 };
 NS_STONE_END
 #endif
\ No newline at end of file
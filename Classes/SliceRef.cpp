@@ -0,0 +1,41 @@
+#include "SliceRef.h"
+#include "Visitor.h"
+#include "Environment.h"
+#include "ArrayRef.h"
+
+NS_STONE_BEGIN
+SliceRef::SliceRef(ASTree* low, ASTree* high)
+	:_hasLow(low != nullptr)
+	,_hasHigh(high != nullptr)
+	,_pure((low == nullptr || ArrayRef::isPureExpr(low)) && (high == nullptr || ArrayRef::isPureExpr(high)))
+{
+	//ֻڵӽڵ
+	if (_hasLow)
+		_children.push_back(low);
+	if (_hasHigh)
+		_children.push_back(high);
+}
+
+ASTree* SliceRef::getLow() const
+{
+	return _hasLow ? this->getChild(0) : nullptr;
+}
+
+ASTree* SliceRef::getHigh() const
+{
+	return _hasHigh ? this->getChild(_hasLow ? 1 : 0) : nullptr;
+}
+
+void SliceRef::accept(Visitor* v, Environment* env)
+{
+	v->visit(this, env);
+}
+
+std::string SliceRef::toString() const
+{
+	std::string low = _hasLow ? getLow()->toString() : "";
+	std::string high = _hasHigh ? getHigh()->toString() : "";
+
+	return "[" + low + ":" + high + "]";
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef __Stone_SliceRef_H__
+#define __Stone_SliceRef_H__
+
+#include <string>
+
+#include "ASTList.h"
+
+NS_STONE_BEGIN
+
+class Visitor;
+class Environment;
+
+/*
+	Ƭ a[low:high]˶ʡԣΪԭ洢ͼ
+*/
+class SliceRef : public ASTList
+{
+public:
+	//lowhighΪnullptr
+	SliceRef(ASTree* low, ASTree* high);
+	//ȡƬˣʡʱnullptr
+	ASTree* getLow() const;
+	ASTree* getHigh() const;
+	//Ƿûи
+	bool isPure() const { return _pure; }
+public:
+	virtual void accept(Visitor* v, Environment* env);
+	virtual std::string toString() const;
+private:
+	bool _hasLow;
+	bool _hasHigh;
+	bool _pure;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
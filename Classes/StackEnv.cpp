@@ -0,0 +1,122 @@
+#include "StackEnv.h"
+#include "FrameLayout.h"
+#include "StoneException.h"
+
+NS_STONE_BEGIN
+
+StackEnv::StackEnv()
+	:_layout(nullptr)
+	,_outer(nullptr)
+{
+}
+
+StackEnv::~StackEnv()
+{
+	this->clear();
+}
+
+void StackEnv::reset(FrameLayout* layout, Environment* outer)
+{
+	layout->retain();
+	outer->retain();
+	_layout = layout;
+	_outer = outer;
+	//֮ǰĿռ
+	_slots.resize(layout->getSize());
+	_bound.assign(layout->getSize(), false);
+}
+
+void StackEnv::clear()
+{
+	for (auto& slot : _slots)
+		slot = Value::Null;
+
+	if (_outer != nullptr)
+	{
+		_outer->release();
+		_outer = nullptr;
+	}
+	if (_layout != nullptr)
+	{
+		_layout->release();
+		_layout = nullptr;
+	}
+}
+
+void StackEnv::bind(unsigned int index, const Value& value)
+{
+	_slots[index] = value;
+	_bound[index] = true;
+}
+
+Environment* StackEnv::getOuter() const
+{
+	return _outer;
+}
+
+Environment* StackEnv::where(const std::string& name)
+{
+	int index = _layout->indexOf(name);
+
+	if (index >= 0 && _bound[index])
+		return this;
+	else if (_outer == nullptr)
+		return nullptr;
+	else
+		return _outer->where(name);
+}
+
+Cell* StackEnv::getCell(const std::string& name)
+{
+	//ջ֡ᱻհ
+	return nullptr;
+}
+
+Value* StackEnv::getLocal(unsigned int index)
+{
+	return _bound[index] ? &_slots[index] : nullptr;
+}
+
+void StackEnv::putNew(const std::string& name, const Value& value)
+{
+	int index = _layout->indexOf(name);
+	//ʱѾóлᱻֵı
+	if (index < 0)
+		throw StoneException("undefined name in frame: " + name);
+
+	this->bind(index, value);
+}
+
+void StackEnv::put(const std::string& name, const Value& value)
+{
+	//ȡñĻ
+	Environment* env = this->where(name);
+
+	if (env == nullptr)
+		env = this;
+
+	env->putNew(name, value);
+}
+
+const Value* StackEnv::get(const std::string& name) const
+{
+	int index = _layout->indexOf(name);
+
+	if (index >= 0 && _bound[index])
+		return &_slots[index];
+	else if (_outer != nullptr)
+		return _outer->get(name);
+	return nullptr;
+}
+
+Value* StackEnv::get(const std::string& name)
+{
+	int index = _layout->indexOf(name);
+
+	if (index >= 0 && _bound[index])
+		return &_slots[index];
+	else if (_outer != nullptr)
+		return _outer->get(name);
+	return nullptr;
+}
+NS_STONE_END
@@ -0,0 +1,46 @@
+#ifndef __Stone_StackEnv_H__
+#define __Stone_StackEnv_H__
+
+#include <vector>
+
+#include "Environment.h"
+
+NS_STONE_BEGIN
+
+class FrameLayout;
+
+/*
+	ջ֡ûݵĺʹõĵû
+	EvalVisitorȸãջֵ֡棬ʱٴµĻ
+*/
+class StackEnv : public Environment
+{
+public:
+	StackEnv();
+	virtual ~StackEnv();
+
+	//ʹǰݲ
+	void reset(FrameLayout* layout, Environment* outer);
+	//ʹú
+	void clear();
+	//ֱӦı
+	void bind(unsigned int index, const Value& value);
+public:
+	virtual Environment* getOuter() const;
+	virtual Environment* where(const std::string& name);
+	virtual Cell* getCell(const std::string& name);
+	virtual Value* getLocal(unsigned int index);
+
+	virtual void putNew(const std::string& name, const Value& value);
+	virtual void put(const std::string& name, const Value& value);
+	virtual const Value* get(const std::string& name) const;
+	virtual Value* get(const std::string& name);
+private:
+	FrameLayout* _layout;
+	std::vector<Value> _slots;
+	//ǷѾֵδֵı㻷
+	std::vector<bool> _bound;
+	Environment* _outer;
+};
+NS_STONE_END
+#endif
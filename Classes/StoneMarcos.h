@@ -8,4 +8,16 @@
 
 #define STONE_SAFE_DELETE(p) do{ if(p) delete p; p=nullptr;}while(0)
 
+//üԣʱͨSTONE_REFCOUNT_POLICYѡ
+//ԭӲֻܵ߳ʹãкڵ߳˳ִ
+#define STONE_REFCOUNT_NONATOMIC 0
+//ԭӲʹrelaxedʹacq_rel
+#define STONE_REFCOUNT_ATOMIC 1
+//ƫ߳ʹ÷ԭӲ߳ʹԭӲ
+#define STONE_REFCOUNT_BIASED 2
+
+#ifndef STONE_REFCOUNT_POLICY
+#define STONE_REFCOUNT_POLICY STONE_REFCOUNT_ATOMIC
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include <cstring>
+
+#include "StringBuilder.h"
+
+NS_STONE_BEGIN
+
+StringBuffer::StringBuffer(size_t capacity)
+	:_data(new char[capacity])
+	,_capacity(capacity)
+	,_size(0)
+{
+}
+
+StringBuffer::~StringBuffer()
+{
+	delete[] _data;
+}
+
+bool StringBuffer::append(size_t length, const char* data, size_t size)
+{
+	if (size > _capacity - length)
+		return false;
+	//ռд룬ͬʱ׷ӵ汾ʧܲ
+	if (!_size.compare_exchange_strong(length, length + size))
+		return false;
+
+	memcpy(_data + length, data, size);
+	return true;
+}
+
+StringBuilder::StringBuilder(StringBuffer* buffer, size_t length)
+	:_buffer(buffer)
+	,_length(length)
+{
+	_buffer->retain();
+}
+
+StringBuilder::~StringBuilder()
+{
+	_buffer->release();
+}
+
+StringBuilder* StringBuilder::create(const char* left, size_t leftSize, const char* right, size_t rightSize)
+{
+	//Ԥռ䣬֮׷
+	StringBuffer* buffer = new StringBuffer((leftSize + rightSize) * 2);
+	buffer->append(0, left, leftSize);
+	buffer->append(leftSize, right, rightSize);
+
+	StringBuilder* builder = new StringBuilder(buffer, leftSize + rightSize);
+	buffer->release();
+
+	return builder;
+}
+
+StringBuilder* StringBuilder::append(const char* data, size_t size) const
+{
+	//Ѿ汾׷ӹ㣬ƵµĻ
+	if (!_buffer->append(_length, data, size))
+		return StringBuilder::create(this->data(), _length, data, size);
+
+	return new StringBuilder(_buffer, _length + size);
+}
+
+std::string StringBuilder::toString() const
+{
+	return std::string(this->data(), _length);
+}
+NS_STONE_END
\ No newline at end of file
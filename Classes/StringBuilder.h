@@ -0,0 +1,56 @@
+#ifndef __Stone_StringBuilder_H__
+#define __Stone_StringBuilder_H__
+
+#include <string>
+#include <atomic>
+
+#include "STObject.h"
+
+NS_STONE_BEGIN
+
+/*
+	ֻĩβ׷ӵַɶStringBuilder
+	̶·䣬дַٸı䣬˸汾ڲͬ߳ͬʱȡ
+*/
+class StringBuffer : public Object
+{
+public:
+	StringBuffer(size_t capacity);
+	virtual ~StringBuffer();
+
+	const char* data() const { return _data; }
+	size_t capacity() const { return _capacity; }
+	//length׷ַֻгΪlength(û汾׷ӹ)㹻ʱɹ
+	bool append(size_t length, const char* data, size_t size);
+private:
+	char* _data;
+	size_t _capacity;
+	//ѱռõĳȣ׷ʱԭӵռ
+	std::atomic<size_t> _size;
+};
+
+/*
+	ַӵַΪеǰlengthַ
+	ֻ׷ӣ˾ɵİ汾Ӱ죻ʱǻ
+	µİ汾ֱ׷ӵУѭַĸӶΪ
+*/
+class StringBuilder : public Object
+{
+public:
+	//ַɣصĶüΪ1
+	static StringBuilder* create(const char* left, size_t leftSize, const char* right, size_t rightSize);
+	virtual ~StringBuilder();
+
+	const char* data() const { return _buffer->data(); }
+	size_t size() const { return _length; }
+	//ĩβַµİ汾üΪ1
+	StringBuilder* append(const char* data, size_t size) const;
+	std::string toString() const;
+private:
+	StringBuilder(StringBuffer* buffer, size_t length);
+private:
+	StringBuffer* _buffer;
+	size_t _length;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
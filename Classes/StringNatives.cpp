@@ -0,0 +1,27 @@
+#include "StringNatives.h"
+#include "Environment.h"
+#include "StoneException.h"
+
+NS_STONE_BEGIN
+
+//substr(s, start, n) startʼnֽڵӴ
+static std::string substr(const std::string& text, int start, int length)
+{
+	if (start < 0 || length < 0 || start > (int)text.size())
+		throw StoneException("substr out of range");
+	return text.substr(start, length);
+}
+
+//find(s, sub) subһγֵλãʱΪ-1
+static int find(const std::string& text, const std::string& sub)
+{
+	size_t pos = text.find(sub);
+	return pos == std::string::npos ? -1 : (int)pos;
+}
+
+void registerStringNatives(Environment* env)
+{
+	env->bindNative("substr", substr);
+	env->bindNative("find", find);
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,17 @@
+#ifndef __Stone_StringNatives_H__
+#define __Stone_StringNatives_H__
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class Environment;
+
+/*
+	ַصıغ substr find
+	ͨbindNative󶨣Ͳʱ׳쳣
+*/
+void registerStringNatives(Environment* env);
+
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include <algorithm>
+
+#include "TaskGroup.h"
+#include "Fiber.h"
+#include "Scheduler.h"
+#include "StoneException.h"
+
+NS_STONE_BEGIN
+
+thread_local TaskGroup* TaskGroup::_current = nullptr;
+
+TaskGroup::TaskGroup()
+	:_held(false)
+	,_waiting(0)
+	,_switches(0)
+	,_parked(0)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+	//ͷ
+	for (auto fiber : _fibers)
+		delete fiber;
+	_fibers.clear();
+}
+
+TaskGroup* TaskGroup::getCurrent()
+{
+	return _current;
+}
+
+void TaskGroup::acquire()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_waiting++;
+	_condition.wait(lock, [this]() { return !_held; });
+	_waiting--;
+	_held = true;
+	_switches++;
+	_current = this;
+}
+
+void TaskGroup::release()
+{
+	//֪ͨȴͷ
+	std::lock_guard<std::mutex> lock(_mutex);
+	_held = false;
+	_current = nullptr;
+	_condition.notify_all();
+}
+
+template<typename Predicate>
+void TaskGroup::releaseAndWait(std::unique_lock<std::mutex>& lock, Predicate pred)
+{
+	_held = false;
+	_condition.notify_all();
+	_condition.wait(lock, [this, &pred]() { return !_held && pred(); });
+	_held = true;
+	_switches++;
+}
+
+void TaskGroup::yield()
+{
+	Fiber* fiber = Fiber::getCurrent();
+	//ȡʹһֱڼ
+	if (fiber != nullptr && fiber->isCancelled())
+		throw StoneException("task cancelled");
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	if (_waiting == 0)
+		return;
+	if (fiber != nullptr)
+	{
+		//ɵͷŶ
+		lock.unlock();
+		fiber->yield();
+		return;
+	}
+	unsigned int switches = _switches;
+	_waiting++;
+	this->releaseAndWait(lock, [this, switches]() { return _switches != switches; });
+	_waiting--;
+}
+
+void TaskGroup::spawn(Function* function)
+{
+	Fiber* fiber = new Fiber(function, this);
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_fibers.push_back(fiber);
+	}
+	Scheduler::getInstance()->schedule(fiber);
+}
+
+void TaskGroup::park(Waiter& waiter)
+{
+	Fiber* fiber = Fiber::getCurrent();
+
+	if (fiber != nullptr)
+	{
+		if (fiber->isCancelled())
+			throw StoneException("task cancelled");
+		waiter.fiber = fiber;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_parked++;
+		}
+		//лص̣߳ͷѺڳ߳м
+		fiber->park();
+		if (fiber->isCancelled())
+			throw StoneException("task cancelled");
+		return;
+	}
+	std::unique_lock<std::mutex> lock(_mutex);
+	this->releaseAndWait(lock, [this, &waiter]() { return waiter.ready || this->isStalled(); });
+	if (!waiter.ready)
+		throw StoneException("deadlock: all tasks are waiting");
+	//wakeʱ˵ȴȡ߳
+	_waiting--;
+}
+
+void TaskGroup::wake(Waiter& waiter)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	waiter.ready = true;
+	if (waiter.fiber != nullptr)
+	{
+		//ȴѾгȺָ̻߳
+		_parked--;
+		Scheduler::getInstance()->schedule(waiter.fiber);
+	}
+	else
+	{
+		//ó񾡿ó
+		_waiting++;
+		_condition.notify_all();
+	}
+}
+
+void TaskGroup::waitAll(bool cancel)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	//ȴеڻָ׳쳣еһóʱ׳
+	if (cancel)
+	{
+		for (auto fiber : _fibers)
+			fiber->cancel();
+	}
+	_held = false;
+	_condition.notify_all();
+
+	while (true)
+	{
+		_condition.wait(lock, [this]() { return _fibers.empty() || (!_held && this->isStalled()); });
+		if (_fibers.empty())
+			break;
+		//ʣڵȴٱѣȡǽ
+		for (auto fiber : _fibers)
+		{
+			fiber->cancel();
+			_parked--;
+			Scheduler::getInstance()->schedule(fiber);
+		}
+	}
+	_waiting++;
+	_condition.wait(lock, [this]() { return !_held; });
+	_waiting--;
+	_held = true;
+	_switches++;
+
+	std::string error;
+	error.swap(_error);
+	lock.unlock();
+	if (!error.empty() && !cancel)
+		throw StoneException(error);
+}
+
+void TaskGroup::resume(Fiber* fiber)
+{
+	this->acquire();
+	fiber->resume();
+
+	switch (fiber->getState())
+	{
+	case Fiber::State::FINISHED:
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_fibers.erase(std::find(_fibers.begin(), _fibers.end(), fiber));
+			if (_error.empty() && !fiber->getError().empty())
+				_error = "error in task: " + fiber->getError();
+		}
+		//ĻʱҪڳʱͷ
+		delete fiber;
+	}break;
+	case Fiber::State::READY:
+		Scheduler::getInstance()->schedule(fiber);
+		break;
+	//ȴ߱ʱµ
+	default:break;
+	}
+	this->release();
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef __Stone_TaskGroup_H__
+#define __Stone_TaskGroup_H__
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class Function;
+class Fiber;
+
+/*
+	һԼ
+	﷨桢ȫֻȶûмűͬһʱֻڳнִ߳
+	нű̺߳͵ִ߳ÿһʱ̵߳ȴʱó
+	ʱͷ˵ȴͨ񣻲мȻʹpmap
+*/
+class TaskGroup
+{
+public:
+	//ͨϵȴ̣߳ǰڵȴ
+	struct Waiter
+	{
+		//Ϊnullptrʱнű߳
+		Fiber* fiber;
+		bool ready;
+
+		Waiter() :fiber(nullptr), ready(false) {}
+	};
+public:
+	TaskGroup();
+	virtual ~TaskGroup();
+
+	//ǰִ߳еĽûгнʱΪnullptr
+	static TaskGroup* getCurrent();
+
+	//ȡͷŽ
+	void acquire();
+	void release();
+	//߳ڵȴʱóеʱصŶ
+	void yield();
+
+	//ִ޲κ
+	void spawn(Function* function);
+	//ͷŽȴwakeʱ³
+	//ȡڵȴ()ʱ׳StoneException
+	void park(Waiter& waiter);
+	//ѵȴߣҪн
+	void wake(Waiter& waiter);
+	//ȴʣڵȴʱȡǣҪн
+	//cancelΪtrueʱȡ(űʱ)쳣ʱ׳һ
+	void waitAll(bool cancel);
+
+	//̵߳ãֱó
+	void resume(Fiber* fiber);
+private:
+	//ͷȴ»ȡʱҪס_mutex
+	template<typename Predicate>
+	void releaseAndWait(std::unique_lock<std::mutex>& lock, Predicate pred);
+	//δڵȴ
+	bool isStalled() const { return _parked == _fibers.size(); }
+private:
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	//Ƿ񱻳
+	bool _held;
+	//ȴȡ߳
+	unsigned int _waiting;
+	//ȡĴóʱжǷѱ߳ȡ
+	unsigned int _switches;
+	//δ
+	std::vector<Fiber*> _fibers;
+	//_fibersдڵȴ״̬ĸ
+	unsigned int _parked;
+	//һ쳣Ĵ
+	std::string _error;
+
+	static thread_local TaskGroup* _current;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "TaskNatives.h"
+#include "Environment.h"
+#include "StoneException.h"
+#include "Function.h"
+#include "TaskGroup.h"
+#include "TaskPool.h"
+#include "Channel.h"
+
+NS_STONE_BEGIN
+
+//ǰ߳ڵĽкͽ֮ⲻʹͨ
+static TaskGroup* getGroup()
+{
+	TaskGroup* group = TaskGroup::getCurrent();
+	if (group == nullptr || TaskPool::isInTask())
+		throw StoneException("tasks and channels are not available here");
+	return group;
+}
+
+static Channel* getChannel(const Value& value)
+{
+	if (value.getType() != Value::Type::CHANNEL)
+		throw StoneException("bad channel");
+	return value.asChannel();
+}
+
+//spawn(f) е޲κf
+static void spawn(Value* args, unsigned int argc, Value* ret)
+{
+	TaskGroup* group = getGroup();
+	if (args[0].getType() != Value::Type::FUNCTION)
+		throw StoneException("bad function");
+	group->spawn(args[0].asFunction());
+}
+
+//channel(n) Ϊnͨ
+static void channel(Value* args, unsigned int argc, Value* ret)
+{
+	getGroup();
+	if (!args[0].isInteger() || args[0].asLong() <= 0 || args[0].asLong() > UINT32_MAX)
+		throw StoneException("bad channel capacity");
+
+	Channel* channel = new Channel((unsigned int)args[0].asLong());
+	*ret = Value(channel);
+	channel->release();
+}
+
+//send(c, v) vͨʱȴֵڱʾܷͨ
+static void send(Value* args, unsigned int argc, Value* ret)
+{
+	getGroup();
+	if (args[1].isNull())
+		throw StoneException("cannot send null");
+	getChannel(args[0])->send(args[1]);
+}
+
+//recv(c) ȡͨеһֵرȡ󷵻ؿֵisnullж
+static void recv(Value* args, unsigned int argc, Value* ret)
+{
+	getGroup();
+	getChannel(args[0])->recv(*ret);
+}
+
+//isnull(v) ǷΪֵȽһ·10recvʱؿֵűûпֵ
+static void isnull(Value* args, unsigned int argc, Value* ret)
+{
+	*ret = args[0].isNull() ? 1 : 0;
+}
+
+//close(c) رͨ
+static void close(Value* args, unsigned int argc, Value* ret)
+{
+	getGroup();
+	getChannel(args[0])->close();
+}
+
+void registerTaskNatives(Environment* env)
+{
+	env->putNative("spawn", spawn, 1);
+	env->putNative("channel", channel, 1);
+	env->putNative("send", send, 2);
+	env->putNative("recv", recv, 1);
+	env->putNative("close", close, 1);
+	env->putNative("isnull", isnull, 1);
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,19 @@
+#ifndef __Stone_TaskNatives_H__
+#define __Stone_TaskNatives_H__
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class Environment;
+
+/*
+	ͨıغ spawn channel send recv close
+	spawn(f)ִ޲κfScheduler̼߳
+	ͨʱǰнű߳ͷŽȴ
+	pmapȲвʹ
+*/
+void registerTaskNatives(Environment* env);
+
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -0,0 +1,270 @@
+#include <deque>
+#include <thread>
+#include <memory>
+#include <exception>
+#include <algorithm>
+
+#include "TaskPool.h"
+#include "EvalVisitor.h"
+#include "STObject.h"
+#include "STAutoreleasePool.h"
+
+//ÿ߳ƽֵĿСʱظ
+#define CHUNKS_PER_THREAD 4
+
+NS_STONE_BEGIN
+
+//һparallelFor
+struct TaskPool::Job
+{
+	const RangeFunc* func;
+	//δɵĿ
+	std::atomic<unsigned int> remaining;
+	//пʧܺʣĿ
+	std::atomic<bool> failed;
+	std::exception_ptr error;
+	std::mutex errorMutex;
+};
+
+struct TaskPool::Task
+{
+	Job* job;
+	unsigned int begin;
+	unsigned int end;
+};
+
+struct TaskPool::Worker
+{
+	std::deque<Task> tasks;
+	std::mutex mutex;
+	EvalVisitor* visitor;
+	std::thread thread;
+	unsigned int index;
+};
+
+TaskPool* TaskPool::_pInstance = nullptr;
+std::mutex TaskPool::_instanceMutex;
+thread_local TaskPool::Worker* TaskPool::_current = nullptr;
+thread_local unsigned int TaskPool::_depth = 0;
+//̵ִ߳߳̽ʱͷ
+static thread_local std::unique_ptr<EvalVisitor> s_callerVisitor;
+
+//ִڼ¼쳣ʱҲָܻ
+struct TaskScope
+{
+	unsigned int& depth;
+
+	TaskScope(unsigned int& d) :depth(d) { depth++; }
+	~TaskScope() { depth--; }
+};
+
+TaskPool* TaskPool::getInstance()
+{
+	//жڲͬ߳ͬʱ
+	std::lock_guard<std::mutex> lock(_instanceMutex);
+	if (_pInstance == nullptr)
+	{
+		//߳Ҳִ
+#if STONE_REFCOUNT_POLICY == STONE_REFCOUNT_NONATOMIC
+		//ṵ̈߳ȫģ̣߳ڵ߳˳ִ
+		_pInstance = new TaskPool(0);
+#else
+		unsigned int count = std::thread::hardware_concurrency();
+		_pInstance = new TaskPool(count > 1 ? count - 1 : 1);
+#endif
+	}
+	return _pInstance;
+}
+
+void TaskPool::purge()
+{
+	std::lock_guard<std::mutex> lock(_instanceMutex);
+	if (_pInstance != nullptr)
+	{
+		delete _pInstance;
+		_pInstance = nullptr;
+	}
+}
+
+TaskPool::TaskPool(unsigned int threadCount)
+	:_pending(0)
+	,_stop(false)
+{
+	for (unsigned int i = 0; i < threadCount; i++)
+	{
+		Worker* worker = new Worker();
+		worker->visitor = new EvalVisitor();
+		worker->visitor->setConcurrent(true);
+		worker->index = i;
+		_workers.push_back(worker);
+	}
+	//ȫ߳л_workers
+	for (auto worker : _workers)
+		worker->thread = std::thread(&TaskPool::run, this, worker);
+}
+
+TaskPool::~TaskPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_condition.notify_all();
+
+	for (auto worker : _workers)
+	{
+		worker->thread.join();
+		delete worker->visitor;
+		delete worker;
+	}
+	_workers.clear();
+}
+
+void TaskPool::parallelFor(unsigned int count, const RangeFunc& func)
+{
+	Worker* self = _current;
+	EvalVisitor* visitor = this->getVisitor();
+	unsigned int chunks = std::min<unsigned int>(count, (_workers.size() + 1) * CHUNKS_PER_THREAD);
+	//ֻһûй߳ʱֱִ
+	if (chunks <= 1 || _workers.empty())
+	{
+		TaskScope scope(_depth);
+		if (count > 0)
+			func(visitor, 0, count);
+		return;
+	}
+	Job job;
+	job.func = &func;
+	job.remaining = chunks;
+	job.failed = false;
+	//߳Ƕ׵ʱԼĶУ߳ȡƽ
+	for (unsigned int i = 0; i < chunks; i++)
+	{
+		Worker* worker = self != nullptr ? self : _workers[i % _workers.size()];
+		Task task = { &job, (unsigned int)((uint64_t)count * i / chunks), (unsigned int)((uint64_t)count * (i + 1) / chunks) };
+
+		std::lock_guard<std::mutex> lock(worker->mutex);
+		worker->tasks.push_back(task);
+	}
+	_pending.fetch_add(chunks);
+	this->notifyAll();
+	//ȴڼæִ
+	while (job.remaining.load(std::memory_order_acquire) > 0)
+	{
+		if (this->runOne(self, visitor))
+			continue;
+		std::unique_lock<std::mutex> lock(_mutex);
+		_condition.wait(lock, [&job, this]() {
+			return job.remaining.load(std::memory_order_acquire) == 0 || _pending.load() > 0;
+		});
+	}
+	if (job.error)
+		std::rethrow_exception(job.error);
+}
+
+bool TaskPool::isInTask()
+{
+	return _depth > 0;
+}
+
+EvalVisitor* TaskPool::getVisitor() const
+{
+	if (_current != nullptr)
+		return _current->visitor;
+	if (s_callerVisitor == nullptr)
+	{
+		s_callerVisitor.reset(new EvalVisitor());
+		s_callerVisitor->setConcurrent(true);
+	}
+	return s_callerVisitor.get();
+}
+
+void TaskPool::run(Worker* worker)
+{
+	_current = worker;
+
+	while (true)
+	{
+		if (this->runOne(worker, worker->visitor))
+		{
+			//֮ûʹõʱձ̵߳ͷų
+			AutoreleasePool::getInstance()->clear();
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(_mutex);
+		_condition.wait(lock, [this]() { return _stop || _pending.load() > 0; });
+		if (_stop)
+			break;
+	}
+	AutoreleasePool::purge();
+}
+
+bool TaskPool::runOne(Worker* self, EvalVisitor* visitor)
+{
+	Task task;
+	if (!this->pop(self, task))
+		return false;
+	_pending.fetch_sub(1);
+
+	Job* job = task.job;
+	if (!job->failed.load(std::memory_order_relaxed))
+	{
+		try
+		{
+			TaskScope scope(_depth);
+			(*job->func)(visitor, task.begin, task.end);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(job->errorMutex);
+			if (!job->error)
+				job->error = std::current_exception();
+			job->failed = true;
+		}
+	}
+	//һɺjobͷţ֮ٷ
+	if (job->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		this->notifyAll();
+	return true;
+}
+
+bool TaskPool::pop(Worker* self, Task& task)
+{
+	if (self != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(self->mutex);
+		if (!self->tasks.empty())
+		{
+			task = self->tasks.back();
+			self->tasks.pop_back();
+			return true;
+		}
+	}
+	//һ߳̿ʼȡⶼڵһ
+	unsigned int start = self != nullptr ? self->index + 1 : 0;
+	for (unsigned int i = 0; i < _workers.size(); i++)
+	{
+		Worker* victim = _workers[(start + i) % _workers.size()];
+		if (victim == self)
+			continue;
+
+		std::lock_guard<std::mutex> lock(victim->mutex);
+		if (!victim->tasks.empty())
+		{
+			task = victim->tasks.front();
+			victim->tasks.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
+
+void TaskPool::notifyAll()
+{
+	//֪ͨȴ̼֪߳ͨ
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+	}
+	_condition.notify_all();
+}
+NS_STONE_END
\ No newline at end of file
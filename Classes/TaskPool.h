@@ -0,0 +1,71 @@
+#ifndef __Stone_TaskPool_H__
+#define __Stone_TaskPool_H__
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+class EvalVisitor;
+
+/*
+	Ĺȡ̳߳أÿ߳ԼкEvalVisitor
+	̴߳Լеĩβȡ񣬶Ϊʱ̶߳еͷȡ
+	ȴɵ߳Ҳִжепٴβ
+	ִڲģʽֻع﷨ͲĻ
+	̳߳ɽڵнãǹ̵߳ĵ߸ʹһִ
+*/
+class TaskPool
+{
+public:
+	//[begin, end)ΧڵԪأvisitorΪִи̵ִ߳
+	typedef std::function<void(EvalVisitor* visitor, unsigned int begin, unsigned int end)> RangeFunc;
+
+	static TaskPool* getInstance();
+	static void purge();
+protected:
+	TaskPool(unsigned int threadCount);
+public:
+	virtual ~TaskPool();
+
+	//[0, count)ֿ鲢дʱȫɣе쳣ڵ߳׳
+	void parallelFor(unsigned int count, const RangeFunc& func);
+	//ǰ߳ʹõִǹ߳ʱظ̵߳ߵִ
+	EvalVisitor* getVisitor() const;
+	//߳߳
+	unsigned int getThreadCount() const { return _workers.size(); }
+	//ǰ߳Ƿִввʹspawnͨ
+	static bool isInTask();
+private:
+	struct Job;
+	struct Task;
+	struct Worker;
+	//̵߳ѭ
+	void run(Worker* worker);
+	//ȡִһûʱfalse
+	bool runOne(Worker* self, EvalVisitor* visitor);
+	//ȴԼĶĩβȡٴͷȡ
+	bool pop(Worker* self, Task& task);
+	void notifyAll();
+private:
+	std::vector<Worker*> _workers;
+	//δȡڿ̵߳ȴ
+	std::atomic<unsigned int> _pending;
+	bool _stop;
+	std::mutex _mutex;
+	std::condition_variable _condition;
+
+	static TaskPool* _pInstance;
+	static std::mutex _instanceMutex;
+	//ǰ̶߳ӦḶ́߳߳Ϊnullptr
+	static thread_local Worker* _current;
+	//ǰִ߳е
+	static thread_local unsigned int _depth;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -2,7 +2,9 @@
 
 NS_STONE_BEGIN
 
-Token* const Token::TOKEN_EOF = new Token(-1);
+//ᱻ޸ĺͷţ
+static Token s_eof(-1);
+Token* const Token::TOKEN_EOF = &s_eof;
 const std::string Token::TOKEN_EOL = "\\n";
 
 Token::Token(int line)
@@ -16,22 +18,53 @@ Token::~Token()
 }
 
 //-------------------------NumToken-----------------------------
-NumToken::NumToken(int line, int value)
+NumToken::NumToken(int line, int64_t value)
 	:Token(line)
 	,_value(value)
+	,_floatValue(static_cast<double>(value))
+	,_isFloat(false)
+{
+	_type = Type::Number;
+}
+
+NumToken::NumToken(int line, double value)
+	:Token(line)
+	,_value(static_cast<int64_t>(value))
+	,_floatValue(value)
+	,_isFloat(true)
+{
+	_type = Type::Number;
+}
+
+NumToken::NumToken(int line, const std::string& digits)
+	:Token(line)
+	,_value(0)
+	,_floatValue(std::stod(digits))
+	,_isFloat(false)
+	,_digits(digits)
 {
 	_type = Type::Number;
 }
 
 std::string NumToken::asString() const
 {
-	return std::to_string(_value);
+	if (!_digits.empty())
+		return _digits;
+	return _isFloat ? std::to_string(_floatValue) : std::to_string(_value);
 }
 
 int NumToken::asInt() const {
+	return static_cast<int>(_value);
+}
+
+int64_t NumToken::asLong() const {
 	return _value;
 }
 
+double NumToken::asDouble() const {
+	return _floatValue;
+}
+
 //-------------------------IdToken-----------------------------
 IdToken::IdToken(int line,const std::string& id)
 	:Token(line)
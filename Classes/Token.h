@@ -2,6 +2,7 @@
 #define __Stone_Token_H__
 
 #include <string>
+#include <cstdint>
 
 #include "StoneMarcos.h"
 
@@ -30,6 +31,12 @@ public:
 	virtual std::string asString() const { return ""; }
 	//ȡ
 	virtual int asInt() const { return 0; }
+	virtual int64_t asLong() const { return 0; }
+	virtual double asDouble() const { return 0.0; }
+	//ǷΪ
+	virtual bool isFloat() const { return false; }
+	//ǷΪint64ʱֻͨasStringȡ
+	virtual bool isBig() const { return false; }
 protected:
 	int _line;
 	Type _type;
@@ -46,11 +53,21 @@ public:
 class NumToken: public Token
 {
 public:
-	NumToken(int line, int value);
+	NumToken(int line, int64_t value);
+	NumToken(int line, double value);
+	//int64
+	NumToken(int line, const std::string& digits);
 	virtual std::string asString() const;
 	virtual int asInt() const;
+	virtual int64_t asLong() const;
+	virtual double asDouble() const;
+	virtual bool isFloat() const { return _isFloat; }
+	virtual bool isBig() const { return !_digits.empty(); }
 private:
-	int _value;
+	int64_t _value;
+	double _floatValue;
+	bool _isFloat;
+	std::string _digits;
 };
 
 /*
@@ -0,0 +1,62 @@
+#include "Upvalues.h"
+
+NS_STONE_BEGIN
+
+Upvalues::Upvalues()
+{
+}
+
+Upvalues::~Upvalues()
+{
+}
+
+int Upvalues::add(const std::string& name)
+{
+	_names.push_back(name);
+	_mutated.push_back(false);
+	_local.push_back(false);
+
+	return _names.size() - 1;
+}
+
+int Upvalues::indexOf(const std::string& name) const
+{
+	//ɱһ٣ֱ˳
+	for (unsigned int i = 0; i < _names.size(); i++)
+	{
+		if (_names[i] == name)
+			return i;
+	}
+	return -1;
+}
+
+unsigned int Upvalues::getSize() const
+{
+	return _names.size();
+}
+
+const std::string& Upvalues::getName(unsigned int index) const
+{
+	return _names.at(index);
+}
+
+bool Upvalues::isMutated(unsigned int index) const
+{
+	return _mutated.at(index);
+}
+
+void Upvalues::setMutated(unsigned int index, bool mutated)
+{
+	_mutated.at(index) = mutated;
+}
+
+bool Upvalues::isLocal(unsigned int index) const
+{
+	return _local.at(index);
+}
+
+void Upvalues::setLocal(unsigned int index, bool local)
+{
+	_local.at(index) = local;
+}
+NS_STONE_END
@@ -0,0 +1,41 @@
+#ifndef __Stone_Upvalues_H__
+#define __Stone_Upvalues_H__
+
+#include <string>
+#include <vector>
+
+#include "STObject.h"
+
+NS_STONE_BEGIN
+
+/*
+	ɱFreeVarVisitoró
+*/
+class Upvalues : public Object
+{
+public:
+	Upvalues();
+	virtual ~Upvalues();
+
+	//ɱ
+	int add(const std::string& name);
+	//ȡӦ򷵻-1
+	int indexOf(const std::string& name) const;
+	//ȡɱ
+	unsigned int getSize() const;
+	//ȡɱ
+	const std::string& getName(unsigned int index) const;
+
+	//ñǷᱻֵֵıҪͨԪ
+	bool isMutated(unsigned int index) const;
+	void setMutated(unsigned int index, bool mutated);
+	//ñǷڱ(ڲ)бֵǺľֲ
+	bool isLocal(unsigned int index) const;
+	void setLocal(unsigned int index, bool local);
+private:
+	std::vector<std::string> _names;
+	std::vector<bool> _mutated;
+	std::vector<bool> _local;
+};
+NS_STONE_END
+#endif
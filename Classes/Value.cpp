@@ -1,5 +1,11 @@
 #include "Value.h"
 #include "Function.h"
+#include "PersistentVector.h"
+#include "ArrayView.h"
+#include "StringBuilder.h"
+#include "BigInt.h"
+#include "Channel.h"
+#include "Generator.h"
 #include "StoneException.h"
 NS_STONE_BEGIN
 
@@ -23,6 +29,12 @@ Value::Value(int v)
 	_field.intVal = v;
 }
 
+Value::Value(int64_t v)
+	: _type(Type::INTEGER)
+{
+	_field.intVal = v;
+}
+
 Value::Value(float v)
 	: _type(Type::FLOAT)
 {
@@ -54,8 +66,13 @@ Value::Value(const char* v)
 Value::Value(const std::string& v)
 	:_type(Type::STRING)
 {
-	_field.stringVal = new std::string();
-	*_field.stringVal = v;
+	_field.stringVal = new std::string(v);
+}
+
+Value::Value(std::string&& v)
+	:_type(Type::STRING)
+{
+	_field.stringVal = new std::string(std::move(v));
 }
 
 Value::Value(Function* function)
@@ -65,6 +82,48 @@ Value::Value(Function* function)
 	_field.functionVal = function;
 }
 
+Value::Value(PersistentVector* vector)
+	:_type(Type::PERSISTENT_VECTOR)
+{
+	vector->retain();
+	_field.persistentVal = vector;
+}
+
+Value::Value(ArrayView* view)
+	:_type(Type::ARRAY_VIEW)
+{
+	view->retain();
+	_field.viewVal = view;
+}
+
+Value::Value(StringBuilder* builder)
+	:_type(Type::STRING_BUILDER)
+{
+	builder->retain();
+	_field.builderVal = builder;
+}
+
+Value::Value(BigInt* number)
+	:_type(Type::BIG_INTEGER)
+{
+	number->retain();
+	_field.bigVal = number;
+}
+
+Value::Value(Channel* channel)
+	:_type(Type::CHANNEL)
+{
+	channel->retain();
+	_field.channelVal = channel;
+}
+
+Value::Value(Generator* generator)
+	:_type(Type::GENERATOR)
+{
+	generator->retain();
+	_field.generatorVal = generator;
+}
+
 Value::Value(const ValueVector& v)
 	: _type(Type::VECTOR)
 {
@@ -92,6 +151,15 @@ Value::Value(const Value& v)
 	*this = v;
 }
 
+Value::Value(Value&& v)
+	: _type(v._type)
+{
+	_field = v._field;
+	//ֱӽӹv
+	v._type = Type::NONE;
+	memset(&v._field, 0, sizeof(v._field));
+}
+
 Value::~Value()
 {
 	clear();
@@ -118,7 +186,8 @@ Value& Value::operator=(const Value& v)
 		if (_field.stringVal == nullptr)
 			_field.stringVal = new std::string();
 
-		*_field.stringVal = v._field.stringVal->c_str();
+		//ȸƣеĿռ䣬ַпԺ'\0'
+		*_field.stringVal = *v._field.stringVal;
 	}; break;
 	case Type::FUNCTION:
 	{
@@ -127,6 +196,54 @@ Value& Value::operator=(const Value& v)
 			_field.functionVal->release();
 		_field.functionVal = v.asFunction();
 	}break;
+	case Type::PERSISTENT_VECTOR:
+	{
+		//ͬһ汾
+		v._field.persistentVal->retain();
+		if (_field.persistentVal != nullptr)
+			_field.persistentVal->release();
+		_field.persistentVal = v._field.persistentVal;
+	}break;
+	case Type::ARRAY_VIEW:
+	{
+		//ͼɱ䣬
+		v._field.viewVal->retain();
+		if (_field.viewVal != nullptr)
+			_field.viewVal->release();
+		_field.viewVal = v._field.viewVal;
+	}break;
+	case Type::STRING_BUILDER:
+	{
+		//ֻ׷ӣ
+		v._field.builderVal->retain();
+		if (_field.builderVal != nullptr)
+			_field.builderVal->release();
+		_field.builderVal = v._field.builderVal;
+	}break;
+	case Type::BIG_INTEGER:
+	{
+		//ɱ䣬ֱӹ
+		v._field.bigVal->retain();
+		if (_field.bigVal != nullptr)
+			_field.bigVal->release();
+		_field.bigVal = v._field.bigVal;
+	}break;
+	case Type::CHANNEL:
+	{
+		//֮ͨ乲
+		v._field.channelVal->retain();
+		if (_field.channelVal != nullptr)
+			_field.channelVal->release();
+		_field.channelVal = v._field.channelVal;
+	}break;
+	case Type::GENERATOR:
+	{
+		//״ֵ̬ͬһ
+		v._field.generatorVal->retain();
+		if (_field.generatorVal != nullptr)
+			_field.generatorVal->release();
+		_field.generatorVal = v._field.generatorVal;
+	}break;
 	case Type::VECTOR:
 	{
 		if (_field.vectorVal == nullptr)
@@ -150,6 +267,21 @@ Value& Value::operator=(const Value& v)
 	return *this;
 }
 
+Value& Value::operator=(Value&& v)
+{
+	if (this == &v)
+		return *this;
+
+	this->clear();
+	_type = v._type;
+	_field = v._field;
+	//ֱӽӹv
+	v._type = Type::NONE;
+	memset(&v._field, 0, sizeof(v._field));
+
+	return *this;
+}
+
 Value& Value::operator=(unsigned char v)
 {
 	reset(Type::BYTE);
@@ -164,6 +296,13 @@ Value& Value::operator=(int v)
 	return *this;
 }
 
+Value& Value::operator=(int64_t v)
+{
+	reset(Type::INTEGER);
+	_field.intVal = v;
+	return *this;
+}
+
 Value& Value::operator=(float v)
 {
 	reset(Type::FLOAT);
@@ -237,6 +376,32 @@ bool Value::operator==(const Value& v)const
 {
 	if (this == &v)
 		return true;
+	//ɵַַͨݱȽ
+	if (_type == Type::STRING_BUILDER || v._type == Type::STRING_BUILDER)
+	{
+		const char* left = nullptr;
+		const char* right = nullptr;
+		size_t leftSize = 0, rightSize = 0;
+
+		return this->getChars(left, leftSize) && v.getChars(right, rightSize)
+			&& leftSize == rightSize && memcmp(left, right, leftSize) == 0;
+	}
+	//ͼ鰴ԪرȽ
+	if (_type == Type::ARRAY_VIEW || v._type == Type::ARRAY_VIEW)
+	{
+		const Value* left = nullptr;
+		const Value* right = nullptr;
+		unsigned int leftSize = 0, rightSize = 0;
+
+		if (!this->getElements(left, leftSize) || !v.getElements(right, rightSize) || leftSize != rightSize)
+			return false;
+		for (unsigned int i = 0; i < leftSize; i++)
+		{
+			if (!(left[i] == right[i]))
+				return false;
+		}
+		return true;
+	}
 	if (_type != v._type)
 		return false;
 	switch (_type)
@@ -253,6 +418,10 @@ bool Value::operator==(const Value& v)const
 	case Type::VECTOR:return *_field.vectorVal == *v._field.vectorVal; break;
 	case Type::MAP:return *_field.mapVal == *v._field.mapVal; break;
 	case Type::INT_KEY_MAP:return *_field.intKeyMapVal == *v._field.intKeyMapVal; break;
+	case Type::PERSISTENT_VECTOR:return _field.persistentVal->equals(v._field.persistentVal); break;
+	case Type::BIG_INTEGER:return _field.bigVal->equals(v._field.bigVal); break;
+	case Type::CHANNEL:return _field.channelVal == v._field.channelVal; break;
+	case Type::GENERATOR:return _field.generatorVal == v._field.generatorVal; break;
 	default:break;
 	}
 	return false;
@@ -262,6 +431,9 @@ bool Value::operator!=(const Value& v)
 {
 	if (this == &v)
 		return false;
+	if (_type == Type::ARRAY_VIEW || v._type == Type::ARRAY_VIEW
+		|| _type == Type::STRING_BUILDER || v._type == Type::STRING_BUILDER)
+		return !(*this == v);
 	if (_type != v._type)
 		return true;
 	switch (_type)
@@ -278,6 +450,10 @@ bool Value::operator!=(const Value& v)
 	case Type::VECTOR:return *_field.vectorVal != *v._field.vectorVal; break;
 	case Type::MAP:return *_field.mapVal != *v._field.mapVal; break;
 	case Type::INT_KEY_MAP:return *_field.intKeyMapVal != *v._field.intKeyMapVal; break;
+	case Type::PERSISTENT_VECTOR:return !_field.persistentVal->equals(v._field.persistentVal); break;
+	case Type::BIG_INTEGER:return !_field.bigVal->equals(v._field.bigVal); break;
+	case Type::CHANNEL:return _field.channelVal != v._field.channelVal; break;
+	case Type::GENERATOR:return _field.generatorVal != v._field.generatorVal; break;
 
 	default:break;
 	}
@@ -298,12 +474,18 @@ unsigned char Value::asByte() const
 	case Type::DOUBLE:return static_cast<unsigned char>(_field.doubleVal); break;
 	case Type::BOOLEAN:return _field.boolVal;
 	case Type::STRING:return static_cast<unsigned char>(std::atoi(_field.stringVal->c_str())); break;
+	case Type::STRING_BUILDER:return static_cast<unsigned char>(std::atoi(this->asString().c_str())); break;
 	default:break;
 	}
 	return 0;
 }
 
 int Value::asInt()const
+{
+	return static_cast<int>(this->asLong());
+}
+
+int64_t Value::asLong()const
 {
 	//޷ת
 	if (_type == Type::VECTOR)
@@ -312,10 +494,12 @@ int Value::asInt()const
 	{
 	case Type::BYTE:return _field.byteVal; break;
 	case Type::INTEGER:return _field.intVal; break;
-	case Type::FLOAT:return static_cast<int>(_field.floatVal); break;
-	case Type::DOUBLE:return static_cast<int>(_field.doubleVal); break;
+	case Type::FLOAT:return static_cast<int64_t>(_field.floatVal); break;
+	case Type::DOUBLE:return static_cast<int64_t>(_field.doubleVal); break;
 	case Type::BOOLEAN:return _field.boolVal;
-	case Type::STRING:return static_cast<int>(atoi(_field.stringVal->c_str())); break;
+	case Type::STRING:return static_cast<int64_t>(atoll(_field.stringVal->c_str())); break;
+	case Type::STRING_BUILDER:return static_cast<int64_t>(atoll(this->asString().c_str())); break;
+	case Type::BIG_INTEGER:return _field.bigVal->toLong(); break;
 	default:break;
 	}
 	return 0;
@@ -334,6 +518,8 @@ float Value::asFloat()const
 	case Type::DOUBLE:return static_cast<float>(_field.doubleVal); break;
 	case Type::BOOLEAN:return _field.boolVal;
 	case Type::STRING:return static_cast<float>(atof(_field.stringVal->c_str())); break;
+	case Type::STRING_BUILDER:return static_cast<float>(atof(this->asString().c_str())); break;
+	case Type::BIG_INTEGER:return static_cast<float>(_field.bigVal->toDouble()); break;
 	default:break;
 	}
 	return 0.f;
@@ -352,6 +538,8 @@ double Value::asDouble()const
 	case Type::DOUBLE:return _field.doubleVal; break;
 	case Type::BOOLEAN:return _field.boolVal;
 	case Type::STRING:return static_cast<double>(atof(_field.stringVal->c_str())); break;
+	case Type::STRING_BUILDER:return static_cast<double>(atof(this->asString().c_str())); break;
+	case Type::BIG_INTEGER:return _field.bigVal->toDouble(); break;
 	default:break;
 	}
 	return 0.0;
@@ -384,6 +572,15 @@ bool Value::asBool() const
 	case Type::STRING:
 		ret = (*_field.stringVal == "0" || *_field.stringVal == "false" ? false : true); 
 		break;
+	case Type::STRING_BUILDER:
+	{
+		std::string str = this->asString();
+		ret = (str == "0" || str == "false" ? false : true);
+	}break;
+	//ܷint64ĶΪ0
+	case Type::BIG_INTEGER:
+		ret = true;
+		break;
 	default:break;
 	}
 	return ret;
@@ -392,31 +589,74 @@ bool Value::asBool() const
 std::string Value::asString()const
 {
 	//޷ת
-	if (_type == Type::VECTOR)
+	if (_type == Type::VECTOR || _type == Type::PERSISTENT_VECTOR || _type == Type::ARRAY_VIEW)
 		return "";
 	if (_type == Type::STRING)
 		return *_field.stringVal;
+	//ҪַʱŸƳ
+	if (_type == Type::STRING_BUILDER)
+		return _field.builderVal->toString();
+	if (_type == Type::BIG_INTEGER)
+		return _field.bigVal->toString();
+
+	char buffer[NUMBER_BUFFER_SIZE];
+	size_t size = this->toChars(buffer, NUMBER_BUFFER_SIZE);
+
+	return std::string(buffer, size);
+}
+
+void Value::appendTo(std::string& buffer) const
+{
+	const char* data = nullptr;
+	size_t size = 0;
 
-	std::stringstream ret;
+	if (this->getChars(data, size))
+	{
+		buffer.append(data, size);
+		return;
+	}
+	if (_type == Type::BIG_INTEGER)
+	{
+		buffer += _field.bigVal->toString();
+		return;
+	}
+	char chars[NUMBER_BUFFER_SIZE];
+	size = this->toChars(chars, NUMBER_BUFFER_SIZE);
+	buffer.append(chars, size);
+}
+
+size_t Value::toChars(char* buffer, size_t size) const
+{
+	std::to_chars_result ret = { buffer, std::errc() };
+	char* last = buffer + size;
+	//Ĭϸʽһ£6λЧ
 	switch (_type)
 	{
 	case Type::BYTE:
-		ret << _field.byteVal; 
+		if (size > 0)
+			*ret.ptr++ = static_cast<char>(_field.byteVal);
 		break;
 	case Type::INTEGER:
-		ret << _field.intVal;
+		ret = std::to_chars(buffer, last, _field.intVal);
 		break;
 	case Type::FLOAT:
-		ret << _field.floatVal;
+		ret = std::to_chars(buffer, last, _field.floatVal, std::chars_format::general, 6);
 		break;
 	case Type::DOUBLE:
-		ret << _field.doubleVal; 
+		ret = std::to_chars(buffer, last, _field.doubleVal, std::chars_format::general, 6);
 		break;
 	case Type::BOOLEAN:
-		ret << (_field.boolVal ? "true" : "false"); 
-		break;
+	{
+		const char* text = _field.boolVal ? "true" : "false";
+		size_t length = strlen(text);
+		if (length <= size)
+			ret.ptr = std::copy(text, text + length, buffer);
+	}break;
+	default:break;
 	}
-	return ret.str();
+	if (ret.ec != std::errc())
+		return 0;
+	return ret.ptr - buffer;
 }
 
 Function* Value::asFunction() const
@@ -426,8 +666,72 @@ Function* Value::asFunction() const
 	return _field.functionVal;
 }
 
+PersistentVector* Value::asPersistentVector() const
+{
+	if (_type != Type::PERSISTENT_VECTOR)
+		throw StoneException("the type is not persistent vector");
+	return _field.persistentVal;
+}
+
+BigInt* Value::asBigInt() const
+{
+	if (_type != Type::BIG_INTEGER)
+		throw StoneException("the type is not big integer");
+	return _field.bigVal;
+}
+
+Channel* Value::asChannel() const
+{
+	if (_type != Type::CHANNEL)
+		throw StoneException("the type is not channel");
+	return _field.channelVal;
+}
+
+Generator* Value::asGenerator() const
+{
+	if (_type != Type::GENERATOR)
+		throw StoneException("the type is not generator");
+	return _field.generatorVal;
+}
+
+StringBuilder* Value::asStringBuilder() const
+{
+	if (_type != Type::STRING_BUILDER)
+		throw StoneException("the type is not string builder");
+	return _field.builderVal;
+}
+
+ArrayView* Value::asArrayView()
+{
+	//ƶ洢УΪͼ
+	if (_type == Type::VECTOR)
+	{
+		ArrayBuffer* buffer = new ArrayBuffer();
+		buffer->values = std::move(*_field.vectorVal);
+		ArrayView* view = new ArrayView(buffer, 0, buffer->values.size());
+		buffer->release();
+
+		this->clear();
+		_type = Type::ARRAY_VIEW;
+		_field.viewVal = view;
+	}
+	else if (_type != Type::ARRAY_VIEW)
+		throw StoneException("the type is not vector");
+	return _field.viewVal;
+}
+
 ValueVector &Value::asValueVector()const
 {
+	//޸ͼǰƳԼ
+	if (_type == Type::ARRAY_VIEW)
+	{
+		Value* self = const_cast<Value*>(this);
+		ValueVector list = _field.viewVal->detach();
+
+		self->clear();
+		self->_type = Type::VECTOR;
+		self->_field.vectorVal = new ValueVector(std::move(list));
+	}
 	if (_type != Type::VECTOR)
 		throw StoneException("the type is not vector");
 	return *_field.vectorVal;
@@ -435,7 +739,7 @@ ValueVector &Value::asValueVector()const
 
 ValueMap &Value::asValueMap()const
 {
-	if (_type != Type::VECTOR)
+	if (_type != Type::MAP)
 		throw StoneException("the type is not map");
 	return *_field.mapVal;
 }
@@ -446,6 +750,53 @@ ValueMapIntKey &Value::asValueIntKey()const
 	return *_field.intKeyMapVal;
 }
 
+bool Value::getChars(const char*& data, size_t& size) const
+{
+	if (_type == Type::STRING)
+	{
+		data = _field.stringVal->data();
+		size = _field.stringVal->size();
+		return true;
+	}
+	else if (_type == Type::STRING_BUILDER)
+	{
+		data = _field.builderVal->data();
+		size = _field.builderVal->size();
+		return true;
+	}
+	return false;
+}
+
+bool Value::getElements(const Value*& data, unsigned int& size) const
+{
+	if (_type == Type::VECTOR)
+	{
+		data = _field.vectorVal->data();
+		size = _field.vectorVal->size();
+		return true;
+	}
+	else if (_type == Type::ARRAY_VIEW)
+	{
+		size = _field.viewVal->size();
+		data = size > 0 ? &_field.viewVal->at(0) : nullptr;
+		return true;
+	}
+	return false;
+}
+
+void Value::borrow(const Value& v)
+{
+	this->clear();
+	_type = v._type;
+	_field = v._field;
+}
+
+void Value::unborrow()
+{
+	//ֻıͣͷ
+	_type = Type::NONE;
+}
+
 void Value::clear()
 {
 	switch (_type)
@@ -460,6 +811,30 @@ void Value::clear()
 		if (_field.functionVal != nullptr)
 			_field.functionVal->release();
 		break;
+	case Type::PERSISTENT_VECTOR:
+		if (_field.persistentVal != nullptr)
+			_field.persistentVal->release();
+		break;
+	case Type::ARRAY_VIEW:
+		if (_field.viewVal != nullptr)
+			_field.viewVal->release();
+		break;
+	case Type::STRING_BUILDER:
+		if (_field.builderVal != nullptr)
+			_field.builderVal->release();
+		break;
+	case Type::BIG_INTEGER:
+		if (_field.bigVal != nullptr)
+			_field.bigVal->release();
+		break;
+	case Type::CHANNEL:
+		if (_field.channelVal != nullptr)
+			_field.channelVal->release();
+		break;
+	case Type::GENERATOR:
+		if (_field.generatorVal != nullptr)
+			_field.generatorVal->release();
+		break;
 	case Type::VECTOR:STONE_SAFE_DELETE(_field.vectorVal); break;
 	case Type::MAP:STONE_SAFE_DELETE(_field.mapVal); break;
 	case Type::INT_KEY_MAP:STONE_SAFE_DELETE(_field.intKeyMapVal); break;
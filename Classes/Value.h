@@ -6,17 +6,29 @@
 #include<vector>
 #include<unordered_map>
 #include<cstdlib>
+#include<cstdint>
 #include<sstream>
+#include<charconv>
 
 #include "StoneMarcos.h"
+#include "HashMap.h"
 
 NS_STONE_BEGIN
 
+//ֵתΪַʱʹõջϻС
+#define NUMBER_BUFFER_SIZE 32
+
 class Value;
 class Function;
+class PersistentVector;
+class ArrayView;
+class StringBuilder;
+class BigInt;
+class Channel;
+class Generator;
 
 typedef std::vector<Value> ValueVector;
-typedef std::unordered_map<std::string, Value> ValueMap;
+typedef HashMap ValueMap;
 typedef std::unordered_map<int, Value> ValueMapIntKey;
 
 class Value
@@ -36,19 +48,31 @@ public:
 		FUNCTION,
 		VECTOR,
 		MAP,
-		INT_KEY_MAP
+		INT_KEY_MAP,
+		PERSISTENT_VECTOR,
+		ARRAY_VIEW,
+		STRING_BUILDER,
+		BIG_INTEGER,
+		CHANNEL,
+		GENERATOR
 	};
 private:
 	Type _type;
 	union
 	{
 		unsigned char byteVal;
-		int intVal;
+		int64_t intVal;
 		float floatVal;
 		double doubleVal;
 		bool boolVal;
 		std::string* stringVal;
 		Function* functionVal;
+		PersistentVector* persistentVal;
+		ArrayView* viewVal;
+		StringBuilder* builderVal;
+		BigInt* bigVal;
+		Channel* channelVal;
+		Generator* generatorVal;
 		ValueVector* vectorVal;
 		ValueMap* mapVal;
 		ValueMapIntKey* intKeyMapVal;
@@ -57,23 +81,36 @@ public:
 	Value();
 	explicit Value(unsigned char v);
 	explicit Value(int v);
+	explicit Value(int64_t v);
 	explicit Value(float v);
 	explicit Value(double v);
 	explicit Value(bool v);
 	explicit Value(const char* v);
 	explicit Value(const std::string& v);
+	//ӹַݣ
+	explicit Value(std::string&& v);
 	explicit Value(Function* function);
+	explicit Value(PersistentVector* vector);
+	explicit Value(ArrayView* view);
+	explicit Value(StringBuilder* builder);
+	explicit Value(BigInt* number);
+	explicit Value(Channel* channel);
+	explicit Value(Generator* generator);
 	explicit Value(const ValueVector& v);
 	explicit Value(const ValueMap& v);
 	explicit Value(const ValueMapIntKey& v);
 	//ƹ캯
 	Value(const Value& v);
+	//ƶ캯vΪֵ
+	Value(Value&& v);
 	~Value();
 	//=
 	Value& operator=(const Value& v);
+	Value& operator=(Value&& v);
 
 	Value& operator=(unsigned char v);
 	Value& operator=(int v);
+	Value& operator=(int64_t v);
 	Value& operator=(float v);
 	Value& operator=(double v);
 	Value& operator=(bool v);
@@ -89,17 +126,46 @@ public:
 	//
 	unsigned char asByte()const;
 	int asInt()const;
+	int64_t asLong()const;
 	float asFloat()const;
 	double asDouble()const;
 	bool asBool()const;
 	std::string asString()const;
+	//ַʽ׷ӵbufferֵʱַ
+	void appendTo(std::string& buffer) const;
+	//ֵдbufferдĳȣַ޷תͷ0
+	size_t toChars(char* buffer, size_t size) const;
 	Function* asFunction() const;
+	PersistentVector* asPersistentVector() const;
+	StringBuilder* asStringBuilder() const;
+	BigInt* asBigInt() const;
+	Channel* asChannel() const;
+	Generator* asGenerator() const;
+	//ȡͼͨᱻתΪͼԱƬ洢
+	ArrayView* asArrayView();
+	//ͼȸƳԼ(дʱ)
 	ValueVector &asValueVector()const;
 	ValueMap &asValueMap()const;
 	ValueMapIntKey &asValueIntKey()const;
+	//ȡַݣƣַ򷵻false
+	bool getChars(const char*& data, size_t& size) const;
+	//ǷΪɲֵ
+	bool isNumber()const { return _type == Type::INTEGER || _type == Type::DOUBLE || _type == Type::FLOAT || _type == Type::BIG_INTEGER; }
+	//ǷΪ
+	bool isInteger()const { return _type == Type::INTEGER || _type == Type::BIG_INTEGER; }
+	//ǷΪ飬ͼ
+	bool isArray()const { return _type == Type::VECTOR || _type == Type::ARRAY_VIEW; }
 	//ǷΪ
 	bool isNull()const { return _type == Type::NONE; }
+	//ǷΪַɵַ
+	bool isString()const { return _type == Type::STRING || _type == Type::STRING_BUILDER; }
 	Type getType()const { return _type; }
+	//ȡͼԪأƣ򷵻false
+	bool getElements(const Value*& data, unsigned int& size) const;
+	//Ƶvݣֻܶȡڼvܱ޸Ļͷţunborrow
+	void borrow(const Value& v);
+	//borrowãΪֵͷõ
+	void unborrow();
 private:
 	void clear();
 	void reset(Type type);
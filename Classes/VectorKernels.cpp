@@ -0,0 +1,608 @@
+#include "VectorKernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STONE_USE_SSE2
+#include <emmintrin.h>
+#endif
+//AVX2ĺָָ룬ʱCPUֺ֧Ż
+#if defined(STONE_USE_SSE2) && (defined(__GNUC__) || defined(_MSC_VER))
+#define STONE_USE_AVX2
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__)
+#define STONE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define STONE_TARGET_AVX2
+#endif
+
+NS_STONE_BEGIN
+
+//1ĸ
+static size_t bitCount(unsigned int mask)
+{
+	size_t count = 0;
+	for (; mask != 0; mask &= mask - 1)
+		count++;
+	return count;
+}
+//------------------------------scalar------------------------------
+static int64_t sumLongScalar(const int64_t* data, size_t size)
+{
+	int64_t ret = 0;
+	for (size_t i = 0; i < size; i++)
+		ret += data[i];
+	return ret;
+}
+
+static double sumDoubleScalar(const double* data, size_t size)
+{
+	double ret = 0.0;
+	for (size_t i = 0; i < size; i++)
+		ret += data[i];
+	return ret;
+}
+
+static int64_t minLongScalar(const int64_t* data, size_t size)
+{
+	int64_t ret = data[0];
+	for (size_t i = 1; i < size; i++)
+		ret = data[i] < ret ? data[i] : ret;
+	return ret;
+}
+
+static int64_t maxLongScalar(const int64_t* data, size_t size)
+{
+	int64_t ret = data[0];
+	for (size_t i = 1; i < size; i++)
+		ret = data[i] > ret ? data[i] : ret;
+	return ret;
+}
+
+static double minDoubleScalar(const double* data, size_t size)
+{
+	double ret = data[0];
+	for (size_t i = 1; i < size; i++)
+		ret = data[i] < ret ? data[i] : ret;
+	return ret;
+}
+
+static double maxDoubleScalar(const double* data, size_t size)
+{
+	double ret = data[0];
+	for (size_t i = 1; i < size; i++)
+		ret = data[i] > ret ? data[i] : ret;
+	return ret;
+}
+
+static int64_t dotLongScalar(const int64_t* left, const int64_t* right, size_t size)
+{
+	int64_t ret = 0;
+	for (size_t i = 0; i < size; i++)
+		ret += left[i] * right[i];
+	return ret;
+}
+
+static double dotDoubleScalar(const double* left, const double* right, size_t size)
+{
+	double ret = 0.0;
+	for (size_t i = 0; i < size; i++)
+		ret += left[i] * right[i];
+	return ret;
+}
+
+static void scaleLongScalar(int64_t* data, size_t size, int64_t factor)
+{
+	for (size_t i = 0; i < size; i++)
+		data[i] *= factor;
+}
+
+static void scaleDoubleScalar(double* data, size_t size, double factor)
+{
+	for (size_t i = 0; i < size; i++)
+		data[i] *= factor;
+}
+
+static void addLongScalar(int64_t* data, const int64_t* other, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+		data[i] += other[i];
+}
+
+static void addDoubleScalar(double* data, const double* other, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+		data[i] += other[i];
+}
+
+static void subLongScalar(int64_t* data, const int64_t* other, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+		data[i] -= other[i];
+}
+
+static void subDoubleScalar(double* data, const double* other, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+		data[i] -= other[i];
+}
+
+static void multiplyLongScalar(int64_t* data, const int64_t* other, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+		data[i] *= other[i];
+}
+
+static void multiplyDoubleScalar(double* data, const double* other, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+		data[i] *= other[i];
+}
+
+static void divideDoubleScalar(double* data, const double* other, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+		data[i] /= other[i];
+}
+
+static size_t countLongScalar(const int64_t* data, size_t size, int64_t value)
+{
+	size_t count = 0;
+	for (size_t i = 0; i < size; i++)
+		count += data[i] == value ? 1 : 0;
+	return count;
+}
+
+static size_t countDoubleScalar(const double* data, size_t size, double value)
+{
+	size_t count = 0;
+	for (size_t i = 0; i < size; i++)
+		count += data[i] == value ? 1 : 0;
+	return count;
+}
+//------------------------------SSE2------------------------------
+//SSE2û64λıȽϺͳ˷Щʹͨѭ
+#ifdef STONE_USE_SSE2
+static int64_t sumLongSSE2(const int64_t* data, size_t size)
+{
+	__m128i acc = _mm_setzero_si128();
+	size_t i = 0;
+
+	for (; i + 2 <= size; i += 2)
+		acc = _mm_add_epi64(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+	int64_t lanes[2];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+	return lanes[0] + lanes[1] + sumLongScalar(data + i, size - i);
+}
+
+static double sumDoubleSSE2(const double* data, size_t size)
+{
+	__m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+	size_t i = 0;
+
+	for (; i + 4 <= size; i += 4)
+	{
+		acc0 = _mm_add_pd(acc0, _mm_loadu_pd(data + i));
+		acc1 = _mm_add_pd(acc1, _mm_loadu_pd(data + i + 2));
+	}
+	double lanes[2];
+	_mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+	return lanes[0] + lanes[1] + sumDoubleScalar(data + i, size - i);
+}
+
+static double minDoubleSSE2(const double* data, size_t size)
+{
+	if (size < 2)
+		return data[0];
+	__m128d acc = _mm_loadu_pd(data);
+	size_t i = 2;
+
+	for (; i + 2 <= size; i += 2)
+		acc = _mm_min_pd(acc, _mm_loadu_pd(data + i));
+	double lanes[2];
+	_mm_storeu_pd(lanes, acc);
+	double ret = lanes[0] < lanes[1] ? lanes[0] : lanes[1];
+	return i < size && data[i] < ret ? data[i] : ret;
+}
+
+static double maxDoubleSSE2(const double* data, size_t size)
+{
+	if (size < 2)
+		return data[0];
+	__m128d acc = _mm_loadu_pd(data);
+	size_t i = 2;
+
+	for (; i + 2 <= size; i += 2)
+		acc = _mm_max_pd(acc, _mm_loadu_pd(data + i));
+	double lanes[2];
+	_mm_storeu_pd(lanes, acc);
+	double ret = lanes[0] > lanes[1] ? lanes[0] : lanes[1];
+	return i < size && data[i] > ret ? data[i] : ret;
+}
+
+static double dotDoubleSSE2(const double* left, const double* right, size_t size)
+{
+	__m128d acc = _mm_setzero_pd();
+	size_t i = 0;
+
+	for (; i + 2 <= size; i += 2)
+		acc = _mm_add_pd(acc, _mm_mul_pd(_mm_loadu_pd(left + i), _mm_loadu_pd(right + i)));
+	double lanes[2];
+	_mm_storeu_pd(lanes, acc);
+	return lanes[0] + lanes[1] + dotDoubleScalar(left + i, right + i, size - i);
+}
+
+static void scaleDoubleSSE2(double* data, size_t size, double factor)
+{
+	__m128d k = _mm_set1_pd(factor);
+	size_t i = 0;
+
+	for (; i + 2 <= size; i += 2)
+		_mm_storeu_pd(data + i, _mm_mul_pd(_mm_loadu_pd(data + i), k));
+	scaleDoubleScalar(data + i, size - i, factor);
+}
+
+static void addLongSSE2(int64_t* data, const int64_t* other, size_t size)
+{
+	size_t i = 0;
+
+	for (; i + 2 <= size; i += 2)
+	{
+		__m128i* p = reinterpret_cast<__m128i*>(data + i);
+		_mm_storeu_si128(p, _mm_add_epi64(_mm_loadu_si128(p), _mm_loadu_si128(reinterpret_cast<const __m128i*>(other + i))));
+	}
+	addLongScalar(data + i, other + i, size - i);
+}
+
+static void addDoubleSSE2(double* data, const double* other, size_t size)
+{
+	size_t i = 0;
+
+	for (; i + 2 <= size; i += 2)
+		_mm_storeu_pd(data + i, _mm_add_pd(_mm_loadu_pd(data + i), _mm_loadu_pd(other + i)));
+	addDoubleScalar(data + i, other + i, size - i);
+}
+
+static void subLongSSE2(int64_t* data, const int64_t* other, size_t size)
+{
+	size_t i = 0;
+
+	for (; i + 2 <= size; i += 2)
+	{
+		__m128i* p = reinterpret_cast<__m128i*>(data + i);
+		_mm_storeu_si128(p, _mm_sub_epi64(_mm_loadu_si128(p), _mm_loadu_si128(reinterpret_cast<const __m128i*>(other + i))));
+	}
+	subLongScalar(data + i, other + i, size - i);
+}
+
+static void subDoubleSSE2(double* data, const double* other, size_t size)
+{
+	size_t i = 0;
+
+	for (; i + 2 <= size; i += 2)
+		_mm_storeu_pd(data + i, _mm_sub_pd(_mm_loadu_pd(data + i), _mm_loadu_pd(other + i)));
+	subDoubleScalar(data + i, other + i, size - i);
+}
+
+static void multiplyDoubleSSE2(double* data, const double* other, size_t size)
+{
+	size_t i = 0;
+
+	for (; i + 2 <= size; i += 2)
+		_mm_storeu_pd(data + i, _mm_mul_pd(_mm_loadu_pd(data + i), _mm_loadu_pd(other + i)));
+	multiplyDoubleScalar(data + i, other + i, size - i);
+}
+
+static void divideDoubleSSE2(double* data, const double* other, size_t size)
+{
+	size_t i = 0;
+
+	for (; i + 2 <= size; i += 2)
+		_mm_storeu_pd(data + i, _mm_div_pd(_mm_loadu_pd(data + i), _mm_loadu_pd(other + i)));
+	divideDoubleScalar(data + i, other + i, size - i);
+}
+
+static size_t countDoubleSSE2(const double* data, size_t size, double value)
+{
+	__m128d v = _mm_set1_pd(value);
+	size_t count = 0, i = 0;
+
+	for (; i + 2 <= size; i += 2)
+		count += bitCount(_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(data + i), v)));
+	return count + countDoubleScalar(data + i, size - i, value);
+}
+#endif
+//------------------------------AVX2------------------------------
+//AVX2û64λ˷dotLongscaleLongmultiplyLongʹͨѭ
+#ifdef STONE_USE_AVX2
+STONE_TARGET_AVX2 static int64_t sumLongAVX2(const int64_t* data, size_t size)
+{
+	__m256i acc = _mm256_setzero_si256();
+	size_t i = 0;
+
+	for (; i + 4 <= size; i += 4)
+		acc = _mm256_add_epi64(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+	int64_t lanes[4];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumLongScalar(data + i, size - i);
+}
+
+STONE_TARGET_AVX2 static double sumDoubleAVX2(const double* data, size_t size)
+{
+	__m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+	size_t i = 0;
+
+	for (; i + 8 <= size; i += 8)
+	{
+		acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(data + i));
+		acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(data + i + 4));
+	}
+	double lanes[4];
+	_mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumDoubleScalar(data + i, size - i);
+}
+
+STONE_TARGET_AVX2 static int64_t minLongAVX2(const int64_t* data, size_t size)
+{
+	if (size < 4)
+		return minLongScalar(data, size);
+	__m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+	size_t i = 4;
+
+	for (; i + 4 <= size; i += 4)
+	{
+		__m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+		acc = _mm256_blendv_epi8(acc, cur, _mm256_cmpgt_epi64(acc, cur));
+	}
+	int64_t lanes[4];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+	int64_t ret = minLongScalar(lanes, 4);
+	for (; i < size; i++)
+		ret = data[i] < ret ? data[i] : ret;
+	return ret;
+}
+
+STONE_TARGET_AVX2 static int64_t maxLongAVX2(const int64_t* data, size_t size)
+{
+	if (size < 4)
+		return maxLongScalar(data, size);
+	__m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+	size_t i = 4;
+
+	for (; i + 4 <= size; i += 4)
+	{
+		__m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+		acc = _mm256_blendv_epi8(acc, cur, _mm256_cmpgt_epi64(cur, acc));
+	}
+	int64_t lanes[4];
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+	int64_t ret = maxLongScalar(lanes, 4);
+	for (; i < size; i++)
+		ret = data[i] > ret ? data[i] : ret;
+	return ret;
+}
+
+STONE_TARGET_AVX2 static double minDoubleAVX2(const double* data, size_t size)
+{
+	if (size < 4)
+		return minDoubleScalar(data, size);
+	__m256d acc = _mm256_loadu_pd(data);
+	size_t i = 4;
+
+	for (; i + 4 <= size; i += 4)
+		acc = _mm256_min_pd(acc, _mm256_loadu_pd(data + i));
+	double lanes[4];
+	_mm256_storeu_pd(lanes, acc);
+	double ret = minDoubleScalar(lanes, 4);
+	for (; i < size; i++)
+		ret = data[i] < ret ? data[i] : ret;
+	return ret;
+}
+
+STONE_TARGET_AVX2 static double maxDoubleAVX2(const double* data, size_t size)
+{
+	if (size < 4)
+		return maxDoubleScalar(data, size);
+	__m256d acc = _mm256_loadu_pd(data);
+	size_t i = 4;
+
+	for (; i + 4 <= size; i += 4)
+		acc = _mm256_max_pd(acc, _mm256_loadu_pd(data + i));
+	double lanes[4];
+	_mm256_storeu_pd(lanes, acc);
+	double ret = maxDoubleScalar(lanes, 4);
+	for (; i < size; i++)
+		ret = data[i] > ret ? data[i] : ret;
+	return ret;
+}
+
+STONE_TARGET_AVX2 static double dotDoubleAVX2(const double* left, const double* right, size_t size)
+{
+	__m256d acc = _mm256_setzero_pd();
+	size_t i = 0;
+	//ʹFMAûFMACPUһ
+	for (; i + 4 <= size; i += 4)
+		acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_loadu_pd(left + i), _mm256_loadu_pd(right + i)));
+	double lanes[4];
+	_mm256_storeu_pd(lanes, acc);
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] + dotDoubleScalar(left + i, right + i, size - i);
+}
+
+STONE_TARGET_AVX2 static void scaleDoubleAVX2(double* data, size_t size, double factor)
+{
+	__m256d k = _mm256_set1_pd(factor);
+	size_t i = 0;
+
+	for (; i + 4 <= size; i += 4)
+		_mm256_storeu_pd(data + i, _mm256_mul_pd(_mm256_loadu_pd(data + i), k));
+	scaleDoubleScalar(data + i, size - i, factor);
+}
+
+STONE_TARGET_AVX2 static void addLongAVX2(int64_t* data, const int64_t* other, size_t size)
+{
+	size_t i = 0;
+
+	for (; i + 4 <= size; i += 4)
+	{
+		__m256i* p = reinterpret_cast<__m256i*>(data + i);
+		_mm256_storeu_si256(p, _mm256_add_epi64(_mm256_loadu_si256(p), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(other + i))));
+	}
+	addLongScalar(data + i, other + i, size - i);
+}
+
+STONE_TARGET_AVX2 static void addDoubleAVX2(double* data, const double* other, size_t size)
+{
+	size_t i = 0;
+
+	for (; i + 4 <= size; i += 4)
+		_mm256_storeu_pd(data + i, _mm256_add_pd(_mm256_loadu_pd(data + i), _mm256_loadu_pd(other + i)));
+	addDoubleScalar(data + i, other + i, size - i);
+}
+
+STONE_TARGET_AVX2 static void subLongAVX2(int64_t* data, const int64_t* other, size_t size)
+{
+	size_t i = 0;
+
+	for (; i + 4 <= size; i += 4)
+	{
+		__m256i* p = reinterpret_cast<__m256i*>(data + i);
+		_mm256_storeu_si256(p, _mm256_sub_epi64(_mm256_loadu_si256(p), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(other + i))));
+	}
+	subLongScalar(data + i, other + i, size - i);
+}
+
+STONE_TARGET_AVX2 static void subDoubleAVX2(double* data, const double* other, size_t size)
+{
+	size_t i = 0;
+
+	for (; i + 4 <= size; i += 4)
+		_mm256_storeu_pd(data + i, _mm256_sub_pd(_mm256_loadu_pd(data + i), _mm256_loadu_pd(other + i)));
+	subDoubleScalar(data + i, other + i, size - i);
+}
+
+STONE_TARGET_AVX2 static void multiplyDoubleAVX2(double* data, const double* other, size_t size)
+{
+	size_t i = 0;
+
+	for (; i + 4 <= size; i += 4)
+		_mm256_storeu_pd(data + i, _mm256_mul_pd(_mm256_loadu_pd(data + i), _mm256_loadu_pd(other + i)));
+	multiplyDoubleScalar(data + i, other + i, size - i);
+}
+
+STONE_TARGET_AVX2 static void divideDoubleAVX2(double* data, const double* other, size_t size)
+{
+	size_t i = 0;
+
+	for (; i + 4 <= size; i += 4)
+		_mm256_storeu_pd(data + i, _mm256_div_pd(_mm256_loadu_pd(data + i), _mm256_loadu_pd(other + i)));
+	divideDoubleScalar(data + i, other + i, size - i);
+}
+
+STONE_TARGET_AVX2 static size_t countLongAVX2(const int64_t* data, size_t size, int64_t value)
+{
+	__m256i v = _mm256_set1_epi64x(value);
+	size_t count = 0, i = 0;
+
+	for (; i + 4 <= size; i += 4)
+	{
+		__m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), v);
+		count += bitCount(_mm256_movemask_pd(_mm256_castsi256_pd(eq)));
+	}
+	return count + countLongScalar(data + i, size - i, value);
+}
+
+STONE_TARGET_AVX2 static size_t countDoubleAVX2(const double* data, size_t size, double value)
+{
+	__m256d v = _mm256_set1_pd(value);
+	size_t count = 0, i = 0;
+
+	for (; i + 4 <= size; i += 4)
+		count += bitCount(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(data + i), v, _CMP_EQ_OQ)));
+	return count + countDoubleScalar(data + i, size - i, value);
+}
+
+//CPUͲϵͳ֧AVX2ʱtrue
+static bool supportsAVX2()
+{
+#if defined(__GNUC__)
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#else
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+	//ϵͳҪYMMĴ
+	__cpuid(info, 1);
+	if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6)
+		return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#endif
+}
+#endif
+//------------------------------VectorKernels------------------------------
+static VectorKernels createKernels()
+{
+	VectorKernels kernels = {
+		sumLongScalar, sumDoubleScalar,
+		minLongScalar, maxLongScalar, minDoubleScalar, maxDoubleScalar,
+		dotLongScalar, dotDoubleScalar,
+		scaleLongScalar, scaleDoubleScalar,
+		addLongScalar, addDoubleScalar,
+		subLongScalar, subDoubleScalar,
+		multiplyLongScalar, multiplyDoubleScalar,
+		divideDoubleScalar,
+		countLongScalar, countDoubleScalar,
+		"scalar"
+	};
+#ifdef STONE_USE_SSE2
+	kernels.sumLong = sumLongSSE2;
+	kernels.sumDouble = sumDoubleSSE2;
+	kernels.minDouble = minDoubleSSE2;
+	kernels.maxDouble = maxDoubleSSE2;
+	kernels.dotDouble = dotDoubleSSE2;
+	kernels.scaleDouble = scaleDoubleSSE2;
+	kernels.addLong = addLongSSE2;
+	kernels.addDouble = addDoubleSSE2;
+	kernels.subLong = subLongSSE2;
+	kernels.subDouble = subDoubleSSE2;
+	kernels.multiplyDouble = multiplyDoubleSSE2;
+	kernels.divideDouble = divideDoubleSSE2;
+	kernels.countDouble = countDoubleSSE2;
+	kernels.name = "sse2";
+#endif
+#ifdef STONE_USE_AVX2
+	if (supportsAVX2())
+	{
+		kernels.sumLong = sumLongAVX2;
+		kernels.sumDouble = sumDoubleAVX2;
+		kernels.minLong = minLongAVX2;
+		kernels.maxLong = maxLongAVX2;
+		kernels.minDouble = minDoubleAVX2;
+		kernels.maxDouble = maxDoubleAVX2;
+		kernels.dotDouble = dotDoubleAVX2;
+		kernels.scaleDouble = scaleDoubleAVX2;
+		kernels.addLong = addLongAVX2;
+		kernels.addDouble = addDoubleAVX2;
+		kernels.subLong = subLongAVX2;
+		kernels.subDouble = subDoubleAVX2;
+		kernels.multiplyDouble = multiplyDoubleAVX2;
+		kernels.divideDouble = divideDoubleAVX2;
+		kernels.countLong = countLongAVX2;
+		kernels.countDouble = countDoubleAVX2;
+		kernels.name = "avx2";
+	}
+#endif
+	return kernels;
+}
+
+const VectorKernels& VectorKernels::getInstance()
+{
+	static VectorKernels kernels = createKernels();
+	return kernels;
+}
+NS_STONE_END
\ No newline at end of file
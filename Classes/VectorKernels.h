@@ -0,0 +1,49 @@
+#ifndef __Stone_VectorKernels_H__
+#define __Stone_VectorKernels_H__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "StoneMarcos.h"
+
+NS_STONE_BEGIN
+
+/*
+	int64/doubleļ㺯CPUֵָ֧ѡ
+	AVX2SSE2ͨѭʵ֣鳤Ϊ0ʱҲԵ(min/max)
+*/
+struct VectorKernels
+{
+	int64_t (*sumLong)(const int64_t* data, size_t size);
+	double (*sumDouble)(const double* data, size_t size);
+	//sizeΪ0
+	int64_t (*minLong)(const int64_t* data, size_t size);
+	int64_t (*maxLong)(const int64_t* data, size_t size);
+	double (*minDouble)(const double* data, size_t size);
+	double (*maxDouble)(const double* data, size_t size);
+	int64_t (*dotLong)(const int64_t* left, const int64_t* right, size_t size);
+	double (*dotDouble)(const double* left, const double* right, size_t size);
+	//data[i] *= factor
+	void (*scaleLong)(int64_t* data, size_t size, int64_t factor);
+	void (*scaleDouble)(double* data, size_t size, double factor);
+	//data[i] += other[i]
+	void (*addLong)(int64_t* data, const int64_t* other, size_t size);
+	void (*addDouble)(double* data, const double* other, size_t size);
+	//data[i] -= other[i]
+	void (*subLong)(int64_t* data, const int64_t* other, size_t size);
+	void (*subDouble)(double* data, const double* other, size_t size);
+	//data[i] *= other[i]
+	void (*multiplyLong)(int64_t* data, const int64_t* other, size_t size);
+	void (*multiplyDouble)(double* data, const double* other, size_t size);
+	//data[i] /= other[i]
+	void (*divideDouble)(double* data, const double* other, size_t size);
+	//valueԪظ
+	size_t (*countLong)(const int64_t* data, size_t size, int64_t value);
+	size_t (*countDouble)(const double* data, size_t size, double value);
+	//ǰʹõָ"avx2" "sse2""scalar"
+	const char* name;
+public:
+	static const VectorKernels& getInstance();
+};
+NS_STONE_END
+#endif
\ No newline at end of file
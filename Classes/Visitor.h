@@ -18,6 +18,8 @@ class BinaryExpr;
 class BlockStmnt;
 class IfStmnt;
 class WhileStmnt;
+class ForStmnt;
+class YieldStmnt;
 
 class PrimaryExpr;
 class Postfix;
@@ -28,6 +30,8 @@ class ClosureStmnt;
 
 class ArrayLiteral;
 class ArrayRef;
+class MapLiteral;
+class SliceRef;
 
 class Visitor
 {
@@ -43,6 +47,7 @@ public:
 	virtual void visit(BlockStmnt* t, Environment* env) = 0;
 	virtual void visit(IfStmnt* t, Environment* env) = 0;
 	virtual void visit(WhileStmnt* t, Environment* env) = 0;
+	virtual void visit(ForStmnt* t, Environment* env) = 0;
 	
 	//
 	virtual void visit(PrimaryExpr* t, Environment* env) = 0;
@@ -53,9 +58,14 @@ public:
 	//հ
 	virtual void visit(ClosureStmnt* t, Environment* env) = 0;
 
+	//
+	virtual void visit(YieldStmnt* t, Environment* env) = 0;
+
 	//
 	virtual void visit(ArrayLiteral* t, Environment* env) = 0;
 	virtual void visit(ArrayRef* t, Environment* env) = 0;
+	virtual void visit(SliceRef* t, Environment* env) = 0;
+	virtual void visit(MapLiteral* t, Environment* env) = 0;
 };
 
 NS_STONE_END
@@ -0,0 +1,25 @@
+#include "YieldStmnt.h"
+#include "Visitor.h"
+
+NS_STONE_BEGIN
+
+YieldStmnt::YieldStmnt(const std::vector<ASTree*>& list)
+	:ASTList(list)
+{
+}
+
+ASTree* YieldStmnt::getValue() const
+{
+	return getChild(0);
+}
+
+void YieldStmnt::accept(Visitor* v, Environment* env)
+{
+	v->visit(this, env);
+}
+
+std::string YieldStmnt::toString() const
+{
+	return "(yield " + getValue()->toString() + ")";
+}
+NS_STONE_END
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef __Stone_YieldStmnt_H__
+#define __Stone_YieldStmnt_H__
+
+#include "ASTList.h"
+
+NS_STONE_BEGIN
+
+class Visitor;
+class Environment;
+
+//yield expr һֵڵ
+class YieldStmnt : public ASTList
+{
+public:
+	YieldStmnt(const std::vector<ASTree*>& list);
+
+	ASTree* getValue() const;
+public:
+	virtual void accept(Visitor* v, Environment* env);
+	virtual std::string toString() const;
+};
+NS_STONE_END
+#endif
\ No newline at end of file
@@ -9,77 +9,152 @@
 #include "Lexer.h"
 #include "Token.h"
 #include "Value.h"
-#include "Parser.h"
 #include "ASTree.h"
-#include "ASTLeaf.h"
 #include "ParseException.h"
 #include "StoneException.h"
-#include "NestedEnv.h"
-#include "EvalVisitor.h"
+#include "Environment.h"
+#include "Interpreter.h"
+#include "TaskPool.h"
+#include "Scheduler.h"
 #include "STAutoreleasePool.h"
+#include "Function.h"
+#include "OutputBuffer.h"
 
 using namespace std;
 USING_NS_STONE;
 
+//дʱĴС
+#define LINE_BUFFER_SIZE (1024 * 1024)
+
 std::unique_ptr<char> getUniqueDataFromFile(const std::string& filename);
 void outputLexer(Lexer* lexer);
-Value print(Environment* env);
-
-int main() {
-	auto uniquePtr = std::move(getUniqueDataFromFile("1.txt"));
+void runLines(Interpreter* interpreter, const std::string& name);
+
+//÷: stone [-l ] [ű]Ĭ1.txt
+//ָ-lʱűִֻһΣ֮Ա׼ÿһеøúawk
+//взķֵԣֻͨprint
+int main(int argc, char* argv[]) {
+	std::string filename = "1.txt";
+	std::string handler;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "-l" && i + 1 < argc)
+			handler = argv[++i];
+		else
+			filename = arg;
+	}
+	auto uniquePtr = std::move(getUniqueDataFromFile(filename));
 	if (uniquePtr == nullptr)
 	{
 		cout << "ļʧ" << endl;
 		return 1;
 	}
-	Lexer* lexer = new Lexer(uniquePtr.get());
-	uniquePtr.reset();
-
-	Parser* parser = new Parser();
-	parser->setLexer(lexer);
-	//
-	NestedEnv* env = new NestedEnv();
-	//뷽
-	const char* params[] = { "value" };
-	env->putNative("print", print, params, 1);
-	//
-	EvalVisitor* visitor = new EvalVisitor();
+	//Ϣܻд
+	ostream& error = handler.empty() ? cout : cerr;
+	int code = 0;
+	//printд
+	Interpreter* interpreter = new Interpreter();
+	OutputBuffer* output = interpreter->getOutput();
+	//дʱ׼Ϊܵһ֣д
+	if (!handler.empty())
+		output->setThreshold(LINE_BUFFER_SIZE);
 
 	try
 	{
-		//ʷ
-		while (lexer->peek(0) != Token::TOKEN_EOF)
+		if (handler.empty())
 		{
-		//﷨
-			auto t = parser->parse();
-
-			if (t != nullptr) 
-			{
-				//
-				t->accept(visitor, env);
-				cout << t->toString() << "=>" << visitor->result->asString() << endl;
-				t->release();
-			}
-			AutoreleasePool::getInstance()->clear();
+			interpreter->run(uniquePtr.get(), [output](ASTree* t, const Value& result) {
+				output->write(t->toString() + "=>" + result.asString() + "\n");
+			});
+		}
+		else
+		{
+			interpreter->run(uniquePtr.get());
+			runLines(interpreter, handler);
 		}
+		//ִнűעI/OͶʱص
+		interpreter->runLoop();
 	}
 	catch (ParseException& e)
 	{
-		cout << e.what() << endl;
+		output->flush();
+		error << e.what() << endl;
+		code = 1;
 	}
 	catch (StoneException& e)
 	{
-		cout << e.what() << endl;
+		output->flush();
+		error << e.what() << endl;
+		code = 1;
 	}
 
-	delete visitor;
-	delete env;
-	delete parser;
-	delete lexer;
-	delete Token::TOKEN_EOF;
+	//Ƚ̣߳߳ƳٵͷſܻŽĻ
+	TaskPool::purge();
+	Scheduler::purge();
+	delete interpreter;
 	AutoreleasePool::purge();
 
-	return 0;
+	return code;
+}
+
+void runLines(Interpreter* interpreter, const std::string& name)
+{
+	//кűڵиֵͬʱᱻͷ
+	Value handler = Value(interpreter->getFunction(name));
+	Function* function = handler.asFunction();
+
+	//ȡڿڲһУƴ
+	std::unique_ptr<char[]> buffer(new char[LINE_BUFFER_SIZE]);
+	const char* begin = nullptr;
+	const char* end = nullptr;
+	std::string partial;
+	bool eof = false;
+
+	//ȡƴӺõУȥCRLFµ\r
+	auto takePartial = [&](Value& line) {
+		if (!partial.empty() && partial.back() == '\r')
+			partial.pop_back();
+		line = Value(std::move(partial));
+		partial.clear();
+	};
+	auto next = [&](Value& line) {
+		while (true)
+		{
+			const char* newline = begin < end ? (const char*)memchr(begin, '\n', end - begin) : nullptr;
+			if (newline != nullptr)
+			{
+				if (partial.empty())
+				{
+					const char* stop = newline > begin && newline[-1] == '\r' ? newline - 1 : newline;
+					line = Value(std::string(begin, stop));
+				}
+				else
+				{
+					partial.append(begin, newline);
+					takePartial(line);
+				}
+				begin = newline + 1;
+				return true;
+			}
+			partial.append(begin, end);
+			begin = end;
+			//һпûлз
+			if (eof)
+			{
+				if (partial.empty())
+					return false;
+				takePartial(line);
+				return true;
+			}
+			size_t n = fread(buffer.get(), 1, LINE_BUFFER_SIZE, stdin);
+			eof = n == 0;
+			begin = buffer.get();
+			end = begin + n;
+		}
+	};
+	//ֵԣʱƥв0printҲ
+	interpreter->invokeEach(function, next, [](const Value& result) {});
 }
 
 void outputLexer(Lexer* lexer)
@@ -128,12 +203,3 @@ std::unique_ptr<char> getUniqueDataFromFile(const std::string& filename) {
 	points = std::unique_ptr<char>(buffer);
 	return points;
 }
-
-Value print(Environment* env)
-{
-	//ȡ
-	const Value* value = env->get("value");
-	std::cout << value->asString() << std::endl;
-
-	return *value;
-}
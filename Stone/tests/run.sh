@@ -0,0 +1,35 @@
+#!/bin/sh
+# عԣбĿ¼µ*.txtͬ.outȽ
+# .outֹ˶ԹÿǵĹһύ
+# ͬ.inʱдʽ: stone -l line x.txt < x.inűеlineÿһ
+# ÷: run.sh <stoneִļ>
+#
+# üֲҪֱ:
+#   -DSTONE_REFCOUNT_POLICY=0  ԭӼкڵ߳˳ִ
+#   -DSTONE_REFCOUNT_POLICY=1  ԭӼ(Ĭ)
+#   -DSTONE_REFCOUNT_POLICY=2  ƫü
+# -fsanitize=address-fsanitize=threadͬʱڴݾ
+# ʹaddressʱҪASAN_OPTIONS=new_delete_type_mismatch=0:alloc_dealloc_mismatch=0
+stone=$(cd "$(dirname "$1")" && pwd)/$(basename "$1")
+dir=$(cd "$(dirname "$0")" && pwd)
+#ʱĿ¼УioԻڵǰĿ¼´ļ
+work=$(mktemp -d)
+cd "$work"
+fail=0
+for f in "$dir"/*.txt; do
+	[ -f "$f" ] || continue
+	if [ -f "${f%.txt}.in" ]; then
+		out=$(timeout 60 "$stone" -l line "$f" < "${f%.txt}.in" 2>&1 | grep -v "ASan doesn't fully support")
+	else
+		out=$(timeout 60 "$stone" "$f" 2>&1 | grep -v "ASan doesn't fully support")
+	fi
+	if [ "$out" = "$(cat "${f%.txt}.out")" ]; then
+		echo "PASS $(basename "$f")"
+	else
+		echo "FAIL $(basename "$f")"
+		echo "$out" | diff - "${f%.txt}.out" | head -20
+		fail=1
+	fi
+done
+cd / && rm -rf "$work"
+exit $fail